@@ -0,0 +1,336 @@
+#include "absl/ascii.h"
+
+#include "absl/cpu_features.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ABSL_ASCII_X86 1
+#include <immintrin.h>
+#endif
+
+namespace absl {
+
+namespace {
+using ascii_internal::AsciiKernels;
+using search_internal::SearchIsa;
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+constexpr char kCaseBit = 'a' - 'A';
+
+// Flips the case of the bytes of w in [first, first + 26), the letters of
+// one case. Each byte is checked against both ends from its low 7 bits,
+// which cannot carry into the next byte; bytes from 0x80 up stay.
+template <char kFirst>
+inline uint64_t FlipCaseSwar(uint64_t w) {
+  const uint64_t low = w & ~kHighBits;
+  const uint64_t from_first = low + kOnes * (0x80 - kFirst);
+  const uint64_t past_last = low + kOnes * (0x80 - (kFirst + 26));
+  const uint64_t letters = (from_first ^ past_last) & ~w & kHighBits;
+  return w ^ (letters >> 2);
+}
+
+template <char kFirst>
+inline char FlipCase(char c) {
+  return c >= kFirst && c < kFirst + 26 ? static_cast<char>(c ^ kCaseBit) : c;
+}
+
+template <char kFirst>
+void ConvertScalar(char* p, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint64_t w;
+    memcpy(&w, p + i, sizeof(w));
+    w = FlipCaseSwar<kFirst>(w);
+    memcpy(p + i, &w, sizeof(w));
+  }
+  for (; i < n; ++i) { p[i] = FlipCase<kFirst>(p[i]); }
+}
+
+bool EqualsIgnoreCaseScalar(const char* a, const char* b, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint64_t x;
+    uint64_t y;
+    memcpy(&x, a + i, sizeof(x));
+    memcpy(&y, b + i, sizeof(y));
+    if (x != y && FlipCaseSwar<'A'>(x) != FlipCaseSwar<'A'>(y)) {
+      return false;
+    }
+  }
+  for (; i < n; ++i) {
+    if (ascii_tolower(a[i]) != ascii_tolower(b[i])) { return false; }
+  }
+  return true;
+}
+
+size_t FindIgnoreCaseScalar(const char* p, size_t n, const char* needle,
+                            size_t m) {
+  const char first = ascii_tolower(needle[0]);
+  for (size_t i = 0; i + m <= n; ++i) {
+    if (ascii_tolower(p[i]) == first &&
+        EqualsIgnoreCaseScalar(p + i + 1, needle + 1, m - 1)) {
+      return i;
+    }
+  }
+  return string_view::npos;
+}
+
+constexpr AsciiKernels kScalarKernels = {
+  ConvertScalar<'A'>, ConvertScalar<'a'>, EqualsIgnoreCaseScalar,
+  FindIgnoreCaseScalar
+};
+
+#ifdef ABSL_ASCII_X86
+
+#define ABSL_TARGET(isa) __attribute__((target(isa)))
+
+// The vectorized case flip moves the letters to the 26 lowest signed bytes
+// by subtracting first + 128, where one signed compare picks them out.
+// Converting is idempotent, so the last partial vector is converted again
+// in full from n - size rather than byte by byte; comparing is done the
+// same way. The search is the generic SIMD substring search of Mula: the
+// candidates are the positions where both the first and the last byte of
+// the needle match, which are then compared in full.
+
+ABSL_TARGET("sse2")
+inline __m128i FlipCaseSse2(__m128i x, char first) {
+  const __m128i moved = _mm_sub_epi8(x, _mm_set1_epi8(first ^ '\x80'));
+  const __m128i letters = _mm_cmplt_epi8(moved, _mm_set1_epi8(-128 + 26));
+  return _mm_xor_si128(x, _mm_and_si128(letters, _mm_set1_epi8(kCaseBit)));
+}
+
+ABSL_TARGET("sse2")
+inline __m128i LoadSse2(const char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+template <char kFirst>
+ABSL_TARGET("sse2")
+inline void Convert16(char* p) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p),
+                   FlipCaseSse2(LoadSse2(p), kFirst));
+}
+
+template <char kFirst>
+ABSL_TARGET("sse2")
+void ConvertSse2(char* p, size_t n) {
+  if (n < 16) { return ConvertScalar<kFirst>(p, n); }
+  for (size_t i = 0; i + 16 <= n; i += 16) { Convert16<kFirst>(p + i); }
+  if (n % 16 != 0) { Convert16<kFirst>(p + n - 16); }
+}
+
+ABSL_TARGET("sse2")
+inline bool EqualsIgnoreCase16(const char* a, const char* b) {
+  const __m128i x = FlipCaseSse2(LoadSse2(a), 'A');
+  const __m128i y = FlipCaseSse2(LoadSse2(b), 'A');
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xffff;
+}
+
+ABSL_TARGET("sse2")
+bool EqualsIgnoreCaseSse2(const char* a, const char* b, size_t n) {
+  if (n < 16) { return EqualsIgnoreCaseScalar(a, b, n); }
+  for (size_t i = 0; i + 16 <= n; i += 16) {
+    if (!EqualsIgnoreCase16(a + i, b + i)) { return false; }
+  }
+  return n % 16 == 0 || EqualsIgnoreCase16(a + n - 16, b + n - 16);
+}
+
+ABSL_TARGET("sse2")
+size_t FindIgnoreCaseSse2(const char* p, size_t n, const char* needle,
+                          size_t m) {
+  const __m128i first = _mm_set1_epi8(ascii_tolower(needle[0]));
+  const __m128i last = _mm_set1_epi8(ascii_tolower(needle[m - 1]));
+  size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    const __m128i f = FlipCaseSse2(LoadSse2(p + i), 'A');
+    const __m128i l = FlipCaseSse2(LoadSse2(p + i + m - 1), 'A');
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(f, first), _mm_cmpeq_epi8(l, last))));
+    for (; mask != 0; mask &= mask - 1) {
+      const size_t pos = i + __builtin_ctz(mask);
+      if (m <= 2 ||
+          EqualsIgnoreCaseSse2(p + pos + 1, needle + 1, m - 2)) {
+        return pos;
+      }
+    }
+  }
+  const size_t pos = FindIgnoreCaseScalar(p + i, n - i, needle, m);
+  return pos == string_view::npos ? pos : i + pos;
+}
+
+constexpr AsciiKernels kSse2Kernels = {
+  ConvertSse2<'A'>, ConvertSse2<'a'>, EqualsIgnoreCaseSse2,
+  FindIgnoreCaseSse2
+};
+
+ABSL_TARGET("avx2")
+inline __m256i FlipCaseAvx2(__m256i x, char first) {
+  const __m256i moved = _mm256_sub_epi8(x, _mm256_set1_epi8(first ^ '\x80'));
+  const __m256i letters =
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), moved);
+  return _mm256_xor_si256(
+      x, _mm256_and_si256(letters, _mm256_set1_epi8(kCaseBit)));
+}
+
+ABSL_TARGET("avx2")
+inline __m256i LoadAvx2(const char* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+template <char kFirst>
+ABSL_TARGET("avx2")
+inline void Convert32(char* p) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),
+                      FlipCaseAvx2(LoadAvx2(p), kFirst));
+}
+
+template <char kFirst>
+ABSL_TARGET("avx2")
+void ConvertAvx2(char* p, size_t n) {
+  if (n < 32) { return ConvertSse2<kFirst>(p, n); }
+  for (size_t i = 0; i + 32 <= n; i += 32) { Convert32<kFirst>(p + i); }
+  if (n % 32 != 0) { Convert32<kFirst>(p + n - 32); }
+}
+
+ABSL_TARGET("avx2")
+inline bool EqualsIgnoreCase32(const char* a, const char* b) {
+  const __m256i x = FlipCaseAvx2(LoadAvx2(a), 'A');
+  const __m256i y = FlipCaseAvx2(LoadAvx2(b), 'A');
+  return _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) == -1;
+}
+
+ABSL_TARGET("avx2")
+bool EqualsIgnoreCaseAvx2(const char* a, const char* b, size_t n) {
+  if (n < 32) { return EqualsIgnoreCaseSse2(a, b, n); }
+  for (size_t i = 0; i + 32 <= n; i += 32) {
+    if (!EqualsIgnoreCase32(a + i, b + i)) { return false; }
+  }
+  return n % 32 == 0 || EqualsIgnoreCase32(a + n - 32, b + n - 32);
+}
+
+ABSL_TARGET("avx2")
+size_t FindIgnoreCaseAvx2(const char* p, size_t n, const char* needle,
+                          size_t m) {
+  const __m256i first = _mm256_set1_epi8(ascii_tolower(needle[0]));
+  const __m256i last = _mm256_set1_epi8(ascii_tolower(needle[m - 1]));
+  size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    const __m256i f = FlipCaseAvx2(LoadAvx2(p + i), 'A');
+    const __m256i l = FlipCaseAvx2(LoadAvx2(p + i + m - 1), 'A');
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(f, first), _mm256_cmpeq_epi8(l, last))));
+    for (; mask != 0; mask &= mask - 1) {
+      const size_t pos = i + __builtin_ctz(mask);
+      if (m <= 2 ||
+          EqualsIgnoreCaseAvx2(p + pos + 1, needle + 1, m - 2)) {
+        return pos;
+      }
+    }
+  }
+  const size_t pos = FindIgnoreCaseSse2(p + i, n - i, needle, m);
+  return pos == string_view::npos ? pos : i + pos;
+}
+
+constexpr AsciiKernels kAvx2Kernels = {
+  ConvertAvx2<'A'>, ConvertAvx2<'a'>, EqualsIgnoreCaseAvx2,
+  FindIgnoreCaseAvx2
+};
+
+#undef ABSL_TARGET
+
+#endif  // ABSL_ASCII_X86
+
+const AsciiKernels& SelectKernels() {
+  for (SearchIsa isa : {SearchIsa::kAvx2, SearchIsa::kSsse3}) {
+    const AsciiKernels* kernels = ascii_internal::GetAsciiKernels(isa);
+    if (kernels != nullptr) { return *kernels; }
+  }
+  return kScalarKernels;
+}
+
+inline const AsciiKernels& Kernels() {
+  static const AsciiKernels& kernels = SelectKernels();
+  return kernels;
+}
+
+const search_internal::CharSet& Whitespace() {
+  static const search_internal::CharSet set(" \t\n\v\f\r");
+  return set;
+}
+}  // namespace
+
+namespace ascii_internal {
+
+const AsciiKernels* GetAsciiKernels(SearchIsa isa) {
+  const CpuFeatures& cpu = GetCpuFeatures();
+  switch (isa) {
+    case SearchIsa::kScalar:
+      return &kScalarKernels;
+#ifdef ABSL_ASCII_X86
+    case SearchIsa::kSsse3:
+      // SSE2 is all these kernels need.
+      return cpu.sse2 ? &kSse2Kernels : nullptr;
+    case SearchIsa::kAvx2:
+      return cpu.avx2 ? &kAvx2Kernels : nullptr;
+#endif
+    default:
+      (void) cpu;
+      return nullptr;
+  }
+}
+
+}  // namespace ascii_internal
+
+bool EqualsIgnoreCase(string_view a, string_view b) {
+  return a.size() == b.size() &&
+         Kernels().equals_ignore_case(a.data(), b.data(), a.size());
+}
+
+bool StartsWithIgnoreCase(string_view text, string_view prefix) {
+  return text.size() >= prefix.size() &&
+         Kernels().equals_ignore_case(text.data(), prefix.data(),
+                                      prefix.size());
+}
+
+bool EndsWithIgnoreCase(string_view text, string_view suffix) {
+  return text.size() >= suffix.size() &&
+         Kernels().equals_ignore_case(
+             text.data() + text.size() - suffix.size(), suffix.data(),
+             suffix.size());
+}
+
+size_t FindIgnoreCase(string_view haystack, string_view needle) {
+  if (needle.empty()) { return 0; }
+  if (needle.size() > haystack.size()) { return string_view::npos; }
+  return Kernels().find_ignore_case(haystack.data(), haystack.size(),
+                                    needle.data(), needle.size());
+}
+
+void AsciiStrToLower(std::string* s) {
+  Kernels().to_lower(&(*s)[0], s->size());
+}
+
+void AsciiStrToUpper(std::string* s) {
+  Kernels().to_upper(&(*s)[0], s->size());
+}
+
+string_view StripLeadingAsciiWhitespace(string_view s) {
+  // Most strings have none, which one byte shows.
+  if (s.empty() || !ascii_isspace(s.front())) { return s; }
+  size_t i = search_internal::GetSearchKernels().find_first_of(
+      s.data(), s.size(), Whitespace(), true);
+  return i == string_view::npos ? s.substr(s.size()) : s.substr(i);
+}
+
+string_view StripTrailingAsciiWhitespace(string_view s) {
+  if (s.empty() || !ascii_isspace(s.back())) { return s; }
+  size_t i = search_internal::GetSearchKernels().find_last_of(
+      s.data(), s.size(), Whitespace(), true);
+  return i == string_view::npos ? s.substr(0, 0) : s.substr(0, i + 1);
+}
+
+string_view StripAsciiWhitespace(string_view s) {
+  return StripTrailingAsciiWhitespace(StripLeadingAsciiWhitespace(s));
+}
+
+}  // namespace absl
@@ -0,0 +1,71 @@
+#ifndef ABSL_ASCII_H_
+#define ABSL_ASCII_H_
+
+#include <string>
+
+#include "absl/char_search.h"
+#include "absl/string_view.h"
+
+namespace absl {
+
+// Character classes and case of ASCII, for text like keys, headers and
+// flags which is not localized. Unlike <cctype> they do not depend on the
+// locale, and bytes from 0x80 up are neither letters nor whitespace, so
+// UTF-8 passes through unchanged.
+constexpr bool ascii_isupper(char c) { return c >= 'A' && c <= 'Z'; }
+constexpr bool ascii_islower(char c) { return c >= 'a' && c <= 'z'; }
+constexpr bool ascii_isalpha(char c) {
+  return ascii_isupper(c) || ascii_islower(c);
+}
+constexpr bool ascii_isdigit(char c) { return c >= '0' && c <= '9'; }
+// Space, \t, \n, \v, \f and \r.
+constexpr bool ascii_isspace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+constexpr char ascii_tolower(char c) {
+  return ascii_isupper(c) ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+constexpr char ascii_toupper(char c) {
+  return ascii_islower(c) ? static_cast<char>(c - ('a' - 'A')) : c;
+}
+
+// The functions below go 16 or 32 bytes at a time with SSE2 or AVX2, and
+// 8 at a time otherwise. None of them allocates.
+
+// Whether a and b are equal when the case of ASCII letters is ignored.
+bool EqualsIgnoreCase(string_view a, string_view b);
+bool StartsWithIgnoreCase(string_view text, string_view prefix);
+bool EndsWithIgnoreCase(string_view text, string_view suffix);
+// The position of the first occurrence of needle in haystack, ignoring the
+// case of ASCII letters, or string_view::npos.
+size_t FindIgnoreCase(string_view haystack, string_view needle);
+inline bool StrContainsIgnoreCase(string_view haystack, string_view needle) {
+  return FindIgnoreCase(haystack, needle) != string_view::npos;
+}
+
+// Convert the ASCII letters of *s in place.
+void AsciiStrToLower(std::string* s);
+void AsciiStrToUpper(std::string* s);
+
+// s without its leading, trailing, or both, ASCII whitespace.
+string_view StripLeadingAsciiWhitespace(string_view s);
+string_view StripTrailingAsciiWhitespace(string_view s);
+string_view StripAsciiWhitespace(string_view s);
+
+namespace ascii_internal {
+struct AsciiKernels {
+  void (*to_lower)(char* p, size_t n);
+  void (*to_upper)(char* p, size_t n);
+  bool (*equals_ignore_case)(const char* a, const char* b, size_t n);
+  // As FindIgnoreCase; the needle is not empty nor longer than n.
+  size_t (*find_ignore_case)(const char* p, size_t n, const char* needle,
+                             size_t needle_size);
+};
+// The kernels of isa, or nullptr if the CPU does not support it or it has
+// none.
+const AsciiKernels* GetAsciiKernels(search_internal::SearchIsa isa);
+}  // namespace ascii_internal
+
+}  // namespace absl
+
+#endif  // ABSL_ASCII_H_
@@ -0,0 +1,470 @@
+#include "absl/char_search.h"
+
+#include "absl/cpu_features.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ABSL_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace absl {
+namespace search_internal {
+
+static constexpr size_t npos = string_view::npos;
+
+CharSet::CharSet(string_view chars) {
+  for (char c : chars) {
+    auto b = static_cast<unsigned char>(c);
+    bits_[b >> 6] |= uint64_t{1} << (b & 63);
+    uint8_t bit = static_cast<uint8_t>(1 << ((b >> 4) & 7));
+    if (b < 0x80) {
+      low_rows_[b & 15] |= bit;
+    } else {
+      high_rows_[b & 15] |= bit;
+    }
+  }
+}
+
+namespace {
+
+size_t FindFirstOfScalar(const char* p, size_t n, const CharSet& set,
+                         bool negate) {
+  for (size_t i = 0; i < n; ++i) {
+    if (set.contains(p[i]) != negate) { return i; }
+  }
+  return npos;
+}
+
+size_t FindLastOfScalar(const char* p, size_t n, const CharSet& set,
+                        bool negate) {
+  for (size_t i = n; i-- > 0;) {
+    if (set.contains(p[i]) != negate) { return i; }
+  }
+  return npos;
+}
+
+size_t FindLastByteScalar(const char* p, size_t n, char c) {
+  for (size_t i = n; i-- > 0;) {
+    if (p[i] == c) { return i; }
+  }
+  return npos;
+}
+
+size_t FindFirstNotByteScalar(const char* p, size_t n, char c) {
+  for (size_t i = 0; i < n; ++i) {
+    if (p[i] != c) { return i; }
+  }
+  return npos;
+}
+
+size_t FindLastNotByteScalar(const char* p, size_t n, char c) {
+  for (size_t i = n; i-- > 0;) {
+    if (p[i] != c) { return i; }
+  }
+  return npos;
+}
+
+size_t FindSubstringScalar(const char* p, size_t n, const char* needle,
+                           size_t needle_size) {
+  if (n < needle_size) { return npos; }
+  const char* end = p + n - needle_size + 1;
+  const char* s = p;
+  while ((s = static_cast<const char*>(memchr(s, needle[0], end - s)))) {
+    if (memcmp(s, needle, needle_size) == 0) { return s - p; }
+    ++s;
+  }
+  return npos;
+}
+
+// Adds base to a position unless it is npos.
+inline size_t Offset(size_t base, size_t pos) {
+  return pos == npos ? npos : base + pos;
+}
+
+const SearchKernels kScalarKernels = {
+  FindFirstOfScalar,
+  FindLastOfScalar,
+  FindLastByteScalar,
+  FindFirstNotByteScalar,
+  FindLastNotByteScalar,
+  FindSubstringScalar,
+};
+
+#ifdef ABSL_SEARCH_X86
+
+#define ABSL_TARGET(isa) __attribute__((target(isa)))
+
+// The set lookups take the low nibble of each byte as an index into the rows
+// of the set, and test the bit the high nibble selects in that row.
+
+ABSL_TARGET("ssse3")
+inline __m128i ClassifySsse3(__m128i x, __m128i low_rows, __m128i high_rows) {
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                     1, 2, 4, 8, 16, 32, 64, -128);
+  __m128i lo = _mm_and_si128(x, nibble);
+  __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), nibble);
+  __m128i high = _mm_cmplt_epi8(x, _mm_setzero_si128());
+  __m128i row = _mm_or_si128(
+      _mm_and_si128(high, _mm_shuffle_epi8(high_rows, lo)),
+      _mm_andnot_si128(high, _mm_shuffle_epi8(low_rows, lo)));
+  __m128i bit = _mm_shuffle_epi8(bits, hi);
+  return _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+}
+
+ABSL_TARGET("ssse3")
+size_t FindFirstOfSsse3(const char* p, size_t n, const CharSet& set,
+                        bool negate) {
+  const __m128i low_rows = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.low_rows()));
+  const __m128i high_rows = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.high_rows()));
+  const unsigned flip = negate ? 0xffff : 0;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    unsigned mask = _mm_movemask_epi8(
+        ClassifySsse3(x, low_rows, high_rows)) ^ flip;
+    if (mask != 0) { return i + __builtin_ctz(mask); }
+  }
+  return Offset(i, FindFirstOfScalar(p + i, n - i, set, negate));
+}
+
+ABSL_TARGET("ssse3")
+size_t FindLastOfSsse3(const char* p, size_t n, const CharSet& set,
+                       bool negate) {
+  const __m128i low_rows = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.low_rows()));
+  const __m128i high_rows = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.high_rows()));
+  const unsigned flip = negate ? 0xffff : 0;
+  size_t i = n;
+  while (i >= 16) {
+    i -= 16;
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    unsigned mask = _mm_movemask_epi8(
+        ClassifySsse3(x, low_rows, high_rows)) ^ flip;
+    if (mask != 0) { return i + 31 - __builtin_clz(mask); }
+  }
+  return FindLastOfScalar(p, i, set, negate);
+}
+
+ABSL_TARGET("sse2")
+size_t FindLastByteSse2(const char* p, size_t n, char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  size_t i = n;
+  while (i >= 16) {
+    i -= 16;
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, needle));
+    if (mask != 0) { return i + 31 - __builtin_clz(mask); }
+  }
+  return FindLastByteScalar(p, i, c);
+}
+
+ABSL_TARGET("sse2")
+size_t FindFirstNotByteSse2(const char* p, size_t n, char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, needle)) ^ 0xffff;
+    if (mask != 0) { return i + __builtin_ctz(mask); }
+  }
+  return Offset(i, FindFirstNotByteScalar(p + i, n - i, c));
+}
+
+ABSL_TARGET("sse2")
+size_t FindLastNotByteSse2(const char* p, size_t n, char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  size_t i = n;
+  while (i >= 16) {
+    i -= 16;
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, needle)) ^ 0xffff;
+    if (mask != 0) { return i + 31 - __builtin_clz(mask); }
+  }
+  return FindLastNotByteScalar(p, i, c);
+}
+
+// Compares the first and the last byte of the needle at 16 positions at
+// once, and only verifies the positions where both match. Unlike memchr on
+// the first byte alone, this skips most false candidates in repetitive text.
+ABSL_TARGET("sse2")
+size_t FindSubstringSse2(const char* p, size_t n, const char* needle,
+                         size_t needle_size) {
+  if (needle_size == 1) {
+    auto* s = static_cast<const char*>(memchr(p, needle[0], n));
+    return s != nullptr ? s - p : npos;
+  }
+  const size_t last = needle_size - 1;
+  const __m128i first_byte = _mm_set1_epi8(needle[0]);
+  const __m128i last_byte = _mm_set1_epi8(needle[last]);
+  size_t i = 0;
+  for (; i + last + 16 <= n; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(p + i + last));
+    unsigned mask = _mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(a, first_byte), _mm_cmpeq_epi8(b, last_byte)));
+    while (mask != 0) {
+      size_t pos = i + __builtin_ctz(mask);
+      if (memcmp(p + pos + 1, needle + 1, last - 1) == 0) { return pos; }
+      mask &= mask - 1;
+    }
+  }
+  return Offset(i, FindSubstringScalar(p + i, n - i, needle, needle_size));
+}
+
+const SearchKernels kSsse3Kernels = {
+  FindFirstOfSsse3,
+  FindLastOfSsse3,
+  FindLastByteSse2,
+  FindFirstNotByteSse2,
+  FindLastNotByteSse2,
+  FindSubstringSse2,
+};
+
+ABSL_TARGET("avx2")
+inline __m256i ClassifyAvx2(__m256i x, __m256i low_rows, __m256i high_rows) {
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  const __m256i bits = _mm256_setr_epi8(
+      1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+      1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  __m256i lo = _mm256_and_si256(x, nibble);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+  __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(low_rows, lo),
+                                   _mm256_shuffle_epi8(high_rows, lo), x);
+  __m256i bit = _mm256_shuffle_epi8(bits, hi);
+  return _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+}
+
+ABSL_TARGET("avx2")
+size_t FindFirstOfAvx2(const char* p, size_t n, const CharSet& set,
+                       bool negate) {
+  const __m256i low_rows = _mm256_broadcastsi128_si256(_mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.low_rows())));
+  const __m256i high_rows = _mm256_broadcastsi128_si256(_mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.high_rows())));
+  const uint32_t flip = negate ? 0xffffffff : 0;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        ClassifyAvx2(x, low_rows, high_rows))) ^ flip;
+    if (mask != 0) { return i + __builtin_ctz(mask); }
+  }
+  return Offset(i, FindFirstOfScalar(p + i, n - i, set, negate));
+}
+
+ABSL_TARGET("avx2")
+size_t FindLastOfAvx2(const char* p, size_t n, const CharSet& set,
+                      bool negate) {
+  const __m256i low_rows = _mm256_broadcastsi128_si256(_mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.low_rows())));
+  const __m256i high_rows = _mm256_broadcastsi128_si256(_mm_load_si128(
+      reinterpret_cast<const __m128i*>(set.high_rows())));
+  const uint32_t flip = negate ? 0xffffffff : 0;
+  size_t i = n;
+  while (i >= 32) {
+    i -= 32;
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        ClassifyAvx2(x, low_rows, high_rows))) ^ flip;
+    if (mask != 0) { return i + 31 - __builtin_clz(mask); }
+  }
+  return FindLastOfScalar(p, i, set, negate);
+}
+
+ABSL_TARGET("avx2")
+size_t FindLastByteAvx2(const char* p, size_t n, char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  size_t i = n;
+  while (i >= 32) {
+    i -= 32;
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    uint32_t mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, needle)));
+    if (mask != 0) { return i + 31 - __builtin_clz(mask); }
+  }
+  return FindLastByteScalar(p, i, c);
+}
+
+ABSL_TARGET("avx2")
+size_t FindFirstNotByteAvx2(const char* p, size_t n, char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    uint32_t mask = ~static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, needle)));
+    if (mask != 0) { return i + __builtin_ctz(mask); }
+  }
+  return Offset(i, FindFirstNotByteScalar(p + i, n - i, c));
+}
+
+ABSL_TARGET("avx2")
+size_t FindLastNotByteAvx2(const char* p, size_t n, char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  size_t i = n;
+  while (i >= 32) {
+    i -= 32;
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    uint32_t mask = ~static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, needle)));
+    if (mask != 0) { return i + 31 - __builtin_clz(mask); }
+  }
+  return FindLastNotByteScalar(p, i, c);
+}
+
+ABSL_TARGET("avx2")
+size_t FindSubstringAvx2(const char* p, size_t n, const char* needle,
+                         size_t needle_size) {
+  if (needle_size == 1) {
+    auto* s = static_cast<const char*>(memchr(p, needle[0], n));
+    return s != nullptr ? s - p : npos;
+  }
+  const size_t last = needle_size - 1;
+  const __m256i first_byte = _mm256_set1_epi8(needle[0]);
+  const __m256i last_byte = _mm256_set1_epi8(needle[last]);
+  size_t i = 0;
+  for (; i + last + 32 <= n; i += 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(p + i + last));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(a, first_byte),
+                         _mm256_cmpeq_epi8(b, last_byte))));
+    while (mask != 0) {
+      size_t pos = i + __builtin_ctz(mask);
+      if (memcmp(p + pos + 1, needle + 1, last - 1) == 0) { return pos; }
+      mask &= mask - 1;
+    }
+  }
+  return Offset(i, FindSubstringSse2(p + i, n - i, needle, needle_size));
+}
+
+const SearchKernels kAvx2Kernels = {
+  FindFirstOfAvx2,
+  FindLastOfAvx2,
+  FindLastByteAvx2,
+  FindFirstNotByteAvx2,
+  FindLastNotByteAvx2,
+  FindSubstringAvx2,
+};
+
+// The AVX-512 scans load the partial block at either end with a mask, which
+// does not fault on the bytes outside the range.
+
+// The 16 bytes at p in each lane. The unmasked broadcasts and shuffles
+// start from an undefined vector, which GCC 12 warns about as
+// uninitialized; the zero masked form with every lane set does not.
+ABSL_TARGET("avx512f")
+inline __m512i BroadcastRowsAvx512(const uint8_t* p) {
+  return _mm512_maskz_broadcast_i32x4(
+      0xffff, _mm_load_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+ABSL_TARGET("avx512f,avx512bw")
+inline __mmask64 ClassifyAvx512(__m512i x, __m512i low_rows,
+                                __m512i high_rows) {
+  const __m512i nibble = _mm512_set1_epi8(0x0f);
+  // The bytes 1, 2, 4, ..., 128 in each 8.
+  const __m512i bits = _mm512_set1_epi64(0x8040201008040201);
+  __m512i lo = _mm512_and_si512(x, nibble);
+  __m512i hi = _mm512_and_si512(_mm512_srli_epi16(x, 4), nibble);
+  __m512i row = _mm512_mask_blend_epi8(_mm512_movepi8_mask(x),
+                                       _mm512_shuffle_epi8(low_rows, lo),
+                                       _mm512_shuffle_epi8(high_rows, lo));
+  return _mm512_test_epi8_mask(row, _mm512_shuffle_epi8(bits, hi));
+}
+
+ABSL_TARGET("avx512f,avx512bw")
+size_t FindFirstOfAvx512(const char* p, size_t n, const CharSet& set,
+                         bool negate) {
+  const __m512i low_rows = BroadcastRowsAvx512(set.low_rows());
+  const __m512i high_rows = BroadcastRowsAvx512(set.high_rows());
+  const uint64_t flip = negate ? ~uint64_t{0} : 0;
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __m512i x = _mm512_loadu_si512(p + i);
+    uint64_t mask = ClassifyAvx512(x, low_rows, high_rows) ^ flip;
+    if (mask != 0) { return i + __builtin_ctzll(mask); }
+  }
+  if (i == n) { return npos; }
+  const uint64_t valid = (uint64_t{1} << (n - i)) - 1;
+  __m512i x = _mm512_maskz_loadu_epi8(valid, p + i);
+  uint64_t mask = (ClassifyAvx512(x, low_rows, high_rows) ^ flip) & valid;
+  return mask != 0 ? i + __builtin_ctzll(mask) : npos;
+}
+
+ABSL_TARGET("avx512f,avx512bw")
+size_t FindLastOfAvx512(const char* p, size_t n, const CharSet& set,
+                        bool negate) {
+  const __m512i low_rows = BroadcastRowsAvx512(set.low_rows());
+  const __m512i high_rows = BroadcastRowsAvx512(set.high_rows());
+  const uint64_t flip = negate ? ~uint64_t{0} : 0;
+  size_t i = n;
+  while (i >= 64) {
+    i -= 64;
+    __m512i x = _mm512_loadu_si512(p + i);
+    uint64_t mask = ClassifyAvx512(x, low_rows, high_rows) ^ flip;
+    if (mask != 0) { return i + 63 - __builtin_clzll(mask); }
+  }
+  if (i == 0) { return npos; }
+  const uint64_t valid = (uint64_t{1} << i) - 1;
+  __m512i x = _mm512_maskz_loadu_epi8(valid, p);
+  uint64_t mask = (ClassifyAvx512(x, low_rows, high_rows) ^ flip) & valid;
+  return mask != 0 ? 63 - __builtin_clzll(mask) : npos;
+}
+
+const SearchKernels kAvx512Kernels = {
+  FindFirstOfAvx512,
+  FindLastOfAvx512,
+  FindLastByteAvx2,
+  FindFirstNotByteAvx2,
+  FindLastNotByteAvx2,
+  FindSubstringAvx2,
+};
+
+#undef ABSL_TARGET
+
+#endif  // ABSL_SEARCH_X86
+
+}  // namespace
+
+const SearchKernels* GetSearchKernels(SearchIsa isa) {
+  const CpuFeatures& cpu = GetCpuFeatures();
+  switch (isa) {
+    case SearchIsa::kScalar:
+      return &kScalarKernels;
+#ifdef ABSL_SEARCH_X86
+    case SearchIsa::kSsse3:
+      return cpu.ssse3 ? &kSsse3Kernels : nullptr;
+    case SearchIsa::kAvx2:
+      return cpu.avx2 ? &kAvx2Kernels : nullptr;
+    case SearchIsa::kAvx512:
+      return cpu.avx2 && cpu.avx512bw ? &kAvx512Kernels : nullptr;
+#endif
+    default:
+      (void) cpu;
+      return nullptr;
+  }
+}
+
+static const SearchKernels* SelectSearchKernels() {
+  for (SearchIsa isa : { SearchIsa::kAvx512, SearchIsa::kAvx2,
+                         SearchIsa::kSsse3 }) {
+    const SearchKernels* kernels = GetSearchKernels(isa);
+    if (kernels != nullptr) { return kernels; }
+  }
+  return &kScalarKernels;
+}
+
+const SearchKernels& GetSearchKernels() {
+  static const SearchKernels* kernels = SelectSearchKernels();
+  return *kernels;
+}
+
+}  // namespace search_internal
+}  // namespace absl
@@ -0,0 +1,64 @@
+#ifndef ABSL_CHAR_SEARCH_H_
+#define ABSL_CHAR_SEARCH_H_
+
+#include <cstdint>
+
+#include "absl/string_view.h"
+
+namespace absl {
+namespace search_internal {
+
+// The kernels behind the searches of string_view. They come in scalar, SSE,
+// AVX2 and AVX-512 variants, and the best one the CPU supports is picked at
+// run time.
+
+// A set of bytes, in the layouts both the scalar and the vectorized scans
+// look bytes up in.
+class CharSet {
+ public:
+  explicit CharSet(string_view chars);
+  bool contains(char c) const {
+    auto b = static_cast<unsigned char>(c);
+    return (bits_[b >> 6] >> (b & 63)) & 1;
+  }
+  // Row l of low_rows() has bit h set if byte (h << 4 | l) is in the set.
+  // high_rows() does the same for the bytes (8 + h) << 4 | l.
+  const uint8_t* low_rows() const { return low_rows_; }
+  const uint8_t* high_rows() const { return high_rows_; }
+ private:
+  uint64_t bits_[4] = {};
+  alignas(16) uint8_t low_rows_[16] = {};
+  alignas(16) uint8_t high_rows_[16] = {};
+};
+
+// The positions the kernels return are offsets into [p, p + n), or npos.
+struct SearchKernels {
+  // The first or last byte which is in the set, or not in it with negate.
+  size_t (*find_first_of)(const char* p, size_t n, const CharSet& set,
+                          bool negate);
+  size_t (*find_last_of)(const char* p, size_t n, const CharSet& set,
+                         bool negate);
+  size_t (*find_last_byte)(const char* p, size_t n, char c);
+  size_t (*find_first_not_byte)(const char* p, size_t n, char c);
+  size_t (*find_last_not_byte)(const char* p, size_t n, char c);
+  // The first occurrence of the needle, which must not be empty.
+  size_t (*find_substring)(const char* p, size_t n, const char* needle,
+                           size_t needle_size);
+};
+
+enum class SearchIsa {
+  kScalar,
+  kSsse3,
+  kAvx2,
+  kAvx512
+};
+
+// Returns the kernels of isa, or nullptr if the CPU does not support it.
+const SearchKernels* GetSearchKernels(SearchIsa isa);
+// Returns the kernels of the best isa the CPU supports.
+const SearchKernels& GetSearchKernels();
+
+}  // namespace search_internal
+}  // namespace absl
+
+#endif  // ABSL_CHAR_SEARCH_H_
@@ -0,0 +1,374 @@
+#include "absl/cord.h"
+
+#include <atomic>
+#include <ostream>
+
+namespace absl {
+namespace cord_internal {
+
+CordRepConcat::CordRepConcat(CordRepPtr l, CordRepPtr r)
+    : CordRep(Tag::kConcat, l->length + r->length), left(std::move(l)),
+      right(std::move(r)) {
+  depth = 1 + std::max(left->depth, right->depth);
+}
+
+string_view LeafData(const CordRep* rep) {
+  switch (rep->tag) {
+    case Tag::kFlat:
+      return static_cast<const CordRepFlat*>(rep)->data;
+    case Tag::kExternal:
+      return static_cast<const CordRepExternal*>(rep)->data;
+    case Tag::kSubstring: {
+      auto* sub = static_cast<const CordRepSubstring*>(rep);
+      return LeafData(sub->child.get()).substr(sub->start, sub->length);
+    }
+    default:
+      return string_view();
+  }
+}
+
+}  // namespace cord_internal
+
+namespace {
+using cord_internal::CordRep;
+using cord_internal::CordRepConcat;
+using cord_internal::CordRepFlat;
+using cord_internal::CordRepPtr;
+using cord_internal::CordRepSubstring;
+using cord_internal::Tag;
+
+// Appends of less are copied into the last chunk, as long as it stays
+// below this size.
+constexpr size_t kMaxFlatLength = 4096;
+// Slices and appended cords of at most this many bytes are copied rather
+// than shared, so they neither pin big chunks nor fragment the tree.
+constexpr size_t kMaxCopyLength = 64;
+// Trees deeper than this are rebuilt balanced.
+constexpr int kMaxDepth = 48;
+
+// Whether this reference is the only one. The fence orders the checks
+// against the release of the references other threads have just dropped.
+bool IsUnique(const CordRepPtr& rep) {
+  if (rep.use_count() != 1) { return false; }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+CordRepPtr NewFlat(string_view s) {
+  return std::make_shared<CordRepFlat>(std::string(s.data(), s.size()));
+}
+
+void CollectLeaves(const CordRepPtr& rep, std::vector<CordRepPtr>* leaves) {
+  if (rep->tag == Tag::kConcat) {
+    auto* concat = static_cast<CordRepConcat*>(rep.get());
+    CollectLeaves(concat->left, leaves);
+    CollectLeaves(concat->right, leaves);
+  } else {
+    leaves->push_back(rep);
+  }
+}
+
+CordRepPtr BuildBalanced(const std::vector<CordRepPtr>& leaves, size_t begin,
+                         size_t end) {
+  if (end - begin == 1) { return leaves[begin]; }
+  size_t middle = begin + (end - begin) / 2;
+  return std::make_shared<CordRepConcat>(BuildBalanced(leaves, begin, middle),
+                                         BuildBalanced(leaves, middle, end));
+}
+
+CordRepPtr Concat(CordRepPtr left, CordRepPtr right) {
+  if (left == nullptr) { return right; }
+  if (right == nullptr) { return left; }
+  auto concat = std::make_shared<CordRepConcat>(std::move(left),
+                                                std::move(right));
+  if (concat->depth <= kMaxDepth) { return concat; }
+  std::vector<CordRepPtr> leaves;
+  CollectLeaves(concat, &leaves);
+  return BuildBalanced(leaves, 0, leaves.size());
+}
+
+// Appends tail to the tree. Along the right spine of the nodes this cord
+// alone holds, tail is hung below the first node whose right side is
+// lower than its left one, so that repeated appends build the tree like a
+// binary counter, of logarithmic depth.
+CordRepPtr AppendNode(CordRepPtr node, CordRepPtr tail) {
+  if (node->tag == Tag::kConcat && IsUnique(node)) {
+    auto* concat = static_cast<CordRepConcat*>(node.get());
+    if (concat->right->depth < concat->left->depth) {
+      concat->right = AppendNode(std::move(concat->right), std::move(tail));
+      concat->length = concat->left->length + concat->right->length;
+      concat->depth = 1 + std::max(concat->left->depth, concat->right->depth);
+      return node;
+    }
+  }
+  return Concat(std::move(node), std::move(tail));
+}
+
+// Appends s to the flat chunk at the end of a tree this cord alone holds.
+// Returns false if there is no such chunk with room for s.
+bool AppendInPlace(CordRep* rep, string_view s) {
+  if (rep->tag == Tag::kConcat) {
+    auto* concat = static_cast<CordRepConcat*>(rep);
+    if (!IsUnique(concat->right) || !AppendInPlace(concat->right.get(), s)) {
+      return false;
+    }
+  } else if (rep->tag == Tag::kFlat) {
+    std::string& data = static_cast<CordRepFlat*>(rep)->data;
+    size_t size = data.size() + s.size();
+    if (size > kMaxFlatLength && size > data.capacity()) { return false; }
+    data.append(s.data(), s.size());
+  } else {
+    return false;
+  }
+  rep->length += s.size();
+  return true;
+}
+
+// Copies the n bytes from pos of the tree to out.
+void CopyRange(const CordRep* rep, size_t pos, size_t n, char* out) {
+  while (rep->tag == Tag::kConcat) {
+    auto* concat = static_cast<const CordRepConcat*>(rep);
+    size_t left = concat->left->length;
+    if (pos >= left) {
+      pos -= left;
+      rep = concat->right.get();
+    } else if (pos + n <= left) {
+      rep = concat->left.get();
+    } else {
+      CopyRange(concat->left.get(), pos, left - pos, out);
+      out += left - pos;
+      n -= left - pos;
+      pos = 0;
+      rep = concat->right.get();
+    }
+  }
+  memcpy(out, cord_internal::LeafData(rep).data() + pos, n);
+}
+
+CordRepPtr SubTree(const CordRepPtr& rep, size_t pos, size_t n) {
+  if (pos == 0 && n == rep->length) { return rep; }
+  switch (rep->tag) {
+    case Tag::kConcat: {
+      auto* concat = static_cast<const CordRepConcat*>(rep.get());
+      size_t left = concat->left->length;
+      if (pos + n <= left) { return SubTree(concat->left, pos, n); }
+      if (pos >= left) { return SubTree(concat->right, pos - left, n); }
+      return Concat(SubTree(concat->left, pos, left - pos),
+                    SubTree(concat->right, 0, pos + n - left));
+    }
+    case Tag::kSubstring: {
+      auto* sub = static_cast<const CordRepSubstring*>(rep.get());
+      return std::make_shared<CordRepSubstring>(sub->child, sub->start + pos,
+                                                n);
+    }
+    default:
+      return std::make_shared<CordRepSubstring>(rep, pos, n);
+  }
+}
+}  // namespace
+
+Cord::ChunkIterator::ChunkIterator(const CordRep* root) {
+  if (root != nullptr) {
+    bytes_left_ = root->length;
+    Descend(root);
+  }
+}
+
+void Cord::ChunkIterator::Descend(const CordRep* rep) {
+  while (rep->tag == Tag::kConcat) {
+    auto* concat = static_cast<const CordRepConcat*>(rep);
+    stack_.push_back(concat->right.get());
+    rep = concat->left.get();
+  }
+  chunk_ = cord_internal::LeafData(rep);
+}
+
+Cord::ChunkIterator& Cord::ChunkIterator::operator++() {
+  bytes_left_ -= chunk_.size();
+  if (stack_.empty()) {
+    chunk_ = string_view();
+  } else {
+    const CordRep* next = stack_.back();
+    stack_.pop_back();
+    Descend(next);
+  }
+  return *this;
+}
+
+Cord::Cord(string_view s) {
+  if (!s.empty()) { rep_ = NewFlat(s); }
+}
+
+void Cord::Append(string_view s) {
+  if (s.empty()) { return; }
+  if (rep_ == nullptr) {
+    rep_ = NewFlat(s);
+    return;
+  }
+  if (s.size() < kMaxFlatLength && IsUnique(rep_) &&
+      AppendInPlace(rep_.get(), s)) {
+    return;
+  }
+  AppendTree(NewFlat(s));
+}
+
+void Cord::Append(const Cord& c) {
+  if (c.size() <= kMaxCopyLength) {
+    // c may be this cord, whose chunks the append moves.
+    char buf[kMaxCopyLength];
+    size_t n = c.size();
+    if (n > 0) { CopyRange(c.rep_.get(), 0, n, buf); }
+    Append(string_view(buf, n));
+  } else {
+    AppendTree(c.rep_);
+  }
+}
+
+void Cord::Append(Cord&& c) {
+  if (&c == this || c.size() <= kMaxCopyLength) {
+    Append(static_cast<const Cord&>(c));
+  } else {
+    AppendTree(std::move(c.rep_));
+    c.Clear();
+  }
+}
+
+void Cord::AppendString(std::string&& s) {
+  if (s.size() < kMaxFlatLength) {
+    Append(string_view(s));
+  } else {
+    AppendTree(std::make_shared<CordRepFlat>(std::move(s)));
+  }
+}
+
+void Cord::AppendTree(CordRepPtr tree) {
+  rep_ = rep_ == nullptr ? std::move(tree)
+                         : AppendNode(std::move(rep_), std::move(tree));
+}
+
+void Cord::Prepend(string_view s) {
+  if (!s.empty()) { rep_ = Concat(NewFlat(s), std::move(rep_)); }
+}
+
+void Cord::Prepend(const Cord& c) {
+  if (c.empty()) { return; }
+  // c may be this cord.
+  CordRepPtr head = c.rep_;
+  rep_ = Concat(std::move(head), std::move(rep_));
+}
+
+Cord Cord::Subcord(size_t pos, size_t n) const {
+  if (pos >= size() || n == 0) { return Cord(); }
+  n = std::min(n, size() - pos);
+  if (n <= kMaxCopyLength) {
+    std::string bytes(n, '\0');
+    CopyRange(rep_.get(), pos, n, &bytes[0]);
+    return Cord(CordRepPtr(std::make_shared<CordRepFlat>(std::move(bytes))));
+  }
+  return Cord(SubTree(rep_, pos, n));
+}
+
+bool Cord::TryFlat(string_view* s) const {
+  if (rep_ == nullptr) {
+    *s = string_view();
+    return true;
+  }
+  if (rep_->tag == Tag::kConcat) { return false; }
+  *s = cord_internal::LeafData(rep_.get());
+  return true;
+}
+
+string_view Cord::Flatten() {
+  string_view s;
+  if (TryFlat(&s)) { return s; }
+  std::string bytes;
+  CopyToString(&bytes);
+  rep_ = std::make_shared<CordRepFlat>(std::move(bytes));
+  return static_cast<CordRepFlat*>(rep_.get())->data;
+}
+
+void Cord::CopyToString(std::string* out) const {
+  out->clear();
+  AppendToString(out);
+}
+
+void Cord::AppendToString(std::string* out) const {
+  size_t n = size();
+  if (n == 0) { return; }
+  size_t offset = out->size();
+  out->resize(offset + n);
+  CopyRange(rep_.get(), 0, n, &(*out)[offset]);
+}
+
+char Cord::operator[](size_t i) const {
+  char c;
+  CopyRange(rep_.get(), i, 1, &c);
+  return c;
+}
+
+int Cord::Compare(string_view s) const {
+  size_t pos = 0;
+  for (string_view chunk : Chunks()) {
+    size_t n = std::min(chunk.size(), s.size() - pos);
+    int result = memcmp(chunk.data(), s.data() + pos, n);
+    if (result != 0) { return result < 0 ? -1 : 1; }
+    if (n < chunk.size()) { return 1; }
+    pos += n;
+  }
+  return pos < s.size() ? -1 : 0;
+}
+
+int Cord::Compare(const Cord& c) const {
+  ChunkIterator a(rep_.get());
+  ChunkIterator b(c.rep_.get());
+  const ChunkIterator end;
+  string_view x;
+  string_view y;
+  while (true) {
+    if (x.empty()) {
+      if (a == end) { break; }
+      x = *a++;
+    }
+    if (y.empty()) {
+      if (b == end) { break; }
+      y = *b++;
+    }
+    size_t n = std::min(x.size(), y.size());
+    int result = memcmp(x.data(), y.data(), n);
+    if (result != 0) { return result < 0 ? -1 : 1; }
+    x.remove_prefix(n);
+    y.remove_prefix(n);
+  }
+  bool a_left = !x.empty() || a != end;
+  bool b_left = !y.empty() || b != end;
+  return a_left == b_left ? 0 : (a_left ? 1 : -1);
+}
+
+bool Cord::StartsWith(string_view prefix) const {
+  if (prefix.size() > size()) { return false; }
+  for (string_view chunk : Chunks()) {
+    size_t n = std::min(chunk.size(), prefix.size());
+    if (memcmp(chunk.data(), prefix.data(), n) != 0) { return false; }
+    prefix.remove_prefix(n);
+    if (prefix.empty()) { break; }
+  }
+  return true;
+}
+
+Cord MakeCordFromExternal(string_view data, std::function<void()> releaser) {
+  if (data.empty()) {
+    if (releaser) { releaser(); }
+    return Cord();
+  }
+  return Cord(CordRepPtr(std::make_shared<cord_internal::CordRepExternal>(
+      data, std::move(releaser))));
+}
+
+std::ostream& operator<<(std::ostream& os, const Cord& c) {
+  for (string_view chunk : c.Chunks()) {
+    os.write(chunk.data(), chunk.size());
+  }
+  return os;
+}
+
+}  // namespace absl
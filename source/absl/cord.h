@@ -0,0 +1,215 @@
+#ifndef ABSL_CORD_H_
+#define ABSL_CORD_H_
+
+#include <functional>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "absl/string_view.h"
+
+namespace absl {
+namespace cord_internal {
+
+enum class Tag : uint8_t { kFlat, kExternal, kSubstring, kConcat };
+
+// A node of the tree of a cord. Shared nodes are immutable; a node which a
+// single cord holds may be appended to in place.
+struct CordRep {
+  CordRep(Tag tag, size_t length) : tag(tag), length(length) { }
+  const Tag tag;
+  size_t length;
+  // The height of the tree below the node, 0 for the leaves.
+  uint8_t depth = 0;
+};
+
+using CordRepPtr = std::shared_ptr<CordRep>;
+
+// Bytes the cord owns.
+struct CordRepFlat : CordRep {
+  explicit CordRepFlat(std::string bytes)
+      : CordRep(Tag::kFlat, bytes.size()), data(std::move(bytes)) { }
+  std::string data;
+};
+
+// Bytes somebody else owns, released when the last cord lets go of them.
+struct CordRepExternal : CordRep {
+  CordRepExternal(string_view bytes, std::function<void()> release)
+      : CordRep(Tag::kExternal, bytes.size()), data(bytes),
+        releaser(std::move(release)) { }
+  ~CordRepExternal() {
+    if (releaser) { releaser(); }
+  }
+  string_view data;
+  std::function<void()> releaser;
+};
+
+// A slice of a flat or external node.
+struct CordRepSubstring : CordRep {
+  CordRepSubstring(CordRepPtr leaf, size_t offset, size_t length)
+      : CordRep(Tag::kSubstring, length), child(std::move(leaf)),
+        start(offset) { }
+  CordRepPtr child;
+  size_t start;
+};
+
+struct CordRepConcat : CordRep {
+  CordRepConcat(CordRepPtr l, CordRepPtr r);
+  CordRepPtr left;
+  CordRepPtr right;
+};
+
+// The bytes of a flat, external or substring node.
+string_view LeafData(const CordRep* rep);
+
+}  // namespace cord_internal
+
+// A string made of reference counted, immutable chunks, for large texts
+// which are built up piece by piece or passed around. Copies, appends of
+// other cords and slices share the chunks instead of copying bytes; short
+// appends are copied into the last chunk. The bytes are only gathered in
+// one buffer on demand, by Flatten().
+//
+//   absl::Cord batch;
+//   for (const auto& record : records) { batch.Append(record); }
+//   for (absl::string_view chunk : batch.Chunks()) { ... }
+//
+// Like the standard containers, a cord may be read from several threads,
+// but not read and modified at once. Modifications invalidate the chunks
+// and the iterators.
+class Cord {
+ public:
+  // Iterates over the chunks of a cord as string_views, none of them empty.
+  class ChunkIterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = string_view;
+    using difference_type = ptrdiff_t;
+    using pointer = const string_view*;
+    using reference = const string_view&;
+
+    ChunkIterator() { }
+    explicit ChunkIterator(const cord_internal::CordRep* root);
+    reference operator*() const { return chunk_; }
+    pointer operator->() const { return &chunk_; }
+    ChunkIterator& operator++();
+    ChunkIterator operator++(int) {
+      ChunkIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    // Only iterators over the same cord compare.
+    bool operator==(const ChunkIterator& other) const {
+      return bytes_left_ == other.bytes_left_;
+    }
+    bool operator!=(const ChunkIterator& other) const {
+      return bytes_left_ != other.bytes_left_;
+    }
+
+   private:
+    void Descend(const cord_internal::CordRep* rep);
+
+    // The right sides of the concat nodes on the way to the current chunk.
+    std::vector<const cord_internal::CordRep*> stack_;
+    string_view chunk_;
+    size_t bytes_left_ = 0;
+  };
+
+  class ChunkRange {
+   public:
+    explicit ChunkRange(const cord_internal::CordRep* root) : root_(root) { }
+    ChunkIterator begin() const { return ChunkIterator(root_); }
+    ChunkIterator end() const { return ChunkIterator(); }
+   private:
+    const cord_internal::CordRep* root_;
+  };
+
+  Cord() { }
+  Cord(string_view s);
+  // Takes the buffer of s over instead of copying it.
+  template <typename String,
+            typename = typename std::enable_if<
+                std::is_same<String, std::string>::value>::type>
+  explicit Cord(String&& s) {
+    Append(std::move(s));
+  }
+
+  size_t size() const { return rep_ ? rep_->length : 0; }
+  bool empty() const { return rep_ == nullptr; }
+  void Clear() { rep_.reset(); }
+
+  void Append(string_view s);
+  void Append(const Cord& c);
+  void Append(Cord&& c);
+  template <typename String,
+            typename = typename std::enable_if<
+                std::is_same<String, std::string>::value>::type>
+  void Append(String&& s) {
+    AppendString(std::move(s));
+  }
+  void Prepend(string_view s);
+  void Prepend(const Cord& c);
+
+  // The n bytes from pos, or as many as there are, sharing the chunks.
+  Cord Subcord(size_t pos, size_t n) const;
+
+  ChunkRange Chunks() const { return ChunkRange(rep_.get()); }
+  // Calls f(string_view) for the chunks, in order.
+  template <typename F>
+  void ForEachChunk(F f) const {
+    for (string_view chunk : Chunks()) { f(chunk); }
+  }
+  // The contents if they are in a single chunk already.
+  bool TryFlat(string_view* s) const;
+  // The contents in a single chunk, which they are copied into if need be.
+  string_view Flatten();
+
+  void CopyToString(std::string* out) const;
+  void AppendToString(std::string* out) const;
+  explicit operator std::string() const {
+    std::string s;
+    CopyToString(&s);
+    return s;
+  }
+
+  char operator[](size_t i) const;
+  int Compare(string_view s) const;
+  int Compare(const Cord& c) const;
+  bool StartsWith(string_view prefix) const;
+
+ private:
+  friend Cord MakeCordFromExternal(string_view data,
+                                   std::function<void()> releaser);
+
+  explicit Cord(cord_internal::CordRepPtr rep) : rep_(std::move(rep)) { }
+  void AppendString(std::string&& s);
+  void AppendTree(cord_internal::CordRepPtr tree);
+
+  cord_internal::CordRepPtr rep_;
+};
+
+// A cord over data which it does not copy. releaser is called, once, when
+// no cord needs data any more.
+Cord MakeCordFromExternal(string_view data, std::function<void()> releaser);
+
+inline bool operator==(const Cord& a, const Cord& b) {
+  return a.size() == b.size() && a.Compare(b) == 0;
+}
+inline bool operator==(const Cord& a, string_view b) {
+  return a.size() == b.size() && a.Compare(b) == 0;
+}
+inline bool operator==(string_view a, const Cord& b) { return b == a; }
+inline bool operator!=(const Cord& a, const Cord& b) { return !(a == b); }
+inline bool operator!=(const Cord& a, string_view b) { return !(a == b); }
+inline bool operator!=(string_view a, const Cord& b) { return !(b == a); }
+inline bool operator<(const Cord& a, const Cord& b) {
+  return a.Compare(b) < 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const Cord& c);
+
+}  // namespace absl
+
+#endif  // ABSL_CORD_H_
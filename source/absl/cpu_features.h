@@ -0,0 +1,21 @@
+#ifndef ABSL_CPU_FEATURES_H_
+#define ABSL_CPU_FEATURES_H_
+
+namespace absl {
+
+// The instruction set extensions which the CPU, and the operating system,
+// make available to the process. All of them are false off x86.
+struct CpuFeatures {
+  bool sse2 = false;
+  bool ssse3 = false;
+  bool sse42 = false;
+  bool avx2 = false;
+  bool bmi2 = false;
+  bool avx512bw = false;
+};
+
+const CpuFeatures& GetCpuFeatures();
+
+}  // namespace absl
+
+#endif  // ABSL_CPU_FEATURES_H_
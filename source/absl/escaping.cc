@@ -0,0 +1,308 @@
+#include "absl/escaping.h"
+
+#include <cstdint>
+
+#include "absl/cpu_features.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ABSL_ESCAPING_X86 1
+#include <immintrin.h>
+#endif
+
+namespace absl {
+
+using search_internal::SearchIsa;
+
+static const char kHexDigits[] = "0123456789abcdef";
+static const char kBase64Chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#if defined(__SSE2__)
+// Turns the nibbles in each byte of n into hex digits.
+static inline __m128i NibblesToHex(__m128i n) {
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i letter_gap = _mm_set1_epi8('a' - '0' - 10);
+  __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(n, nine), letter_gap);
+  return _mm_add_epi8(_mm_add_epi8(n, zero), letters);
+}
+#endif
+
+size_t HexEncode(string_view src, char* dest) {
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(src.data());
+  size_t n = src.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i low_nibbles = _mm_set1_epi8(0x0f);
+  for (; i + 16 <= n; i += 16) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    __m128i hi = NibblesToHex(
+        _mm_and_si128(_mm_srli_epi16(in, 4), low_nibbles));
+    __m128i lo = NibblesToHex(_mm_and_si128(in, low_nibbles));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i),
+                     _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i + 16),
+                     _mm_unpackhi_epi8(hi, lo));
+  }
+#endif
+  for (; i < n; ++i) {
+    dest[2 * i] = kHexDigits[p[i] >> 4];
+    dest[2 * i + 1] = kHexDigits[p[i] & 0x0f];
+  }
+  return 2 * n;
+}
+
+static size_t Base64EncodeScalar(string_view src, char* dest) {
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(src.data());
+  size_t n = src.size();
+  char* out = dest;
+  size_t i = 0;
+  // Six bytes at a time: load them as one big endian word and cut it into
+  // eight sextets.
+  for (; i + 6 <= n; i += 6) {
+    uint64_t word = 0;
+    for (int k = 0; k < 6; ++k) { word = (word << 8) | p[i + k]; }
+    for (int k = 7; k >= 0; --k) {
+      out[k] = kBase64Chars[word & 0x3f];
+      word >>= 6;
+    }
+    out += 8;
+  }
+  for (; i + 3 <= n; i += 3) {
+    uint32_t word = (p[i] << 16) | (p[i + 1] << 8) | p[i + 2];
+    out[0] = kBase64Chars[word >> 18];
+    out[1] = kBase64Chars[(word >> 12) & 0x3f];
+    out[2] = kBase64Chars[(word >> 6) & 0x3f];
+    out[3] = kBase64Chars[word & 0x3f];
+    out += 4;
+  }
+  if (i < n) {
+    uint32_t word = p[i] << 16;
+    if (i + 1 < n) { word |= p[i + 1] << 8; }
+    out[0] = kBase64Chars[word >> 18];
+    out[1] = kBase64Chars[(word >> 12) & 0x3f];
+    out[2] = i + 1 < n ? kBase64Chars[(word >> 6) & 0x3f] : '=';
+    out[3] = '=';
+    out += 4;
+  }
+  return out - dest;
+}
+
+#ifdef ABSL_ESCAPING_X86
+
+#define ABSL_TARGET(isa) __attribute__((target(isa)))
+
+// The vectorized encoding of Mula and Lemire. A shuffle spreads each group
+// of three bytes over a 32-bit lane in the order [b1 b0 b2 b1], where two
+// multiplies move the four sextets to the low bits of the four bytes. The
+// sextets then become chars by adding an offset, which a shuffle looks up
+// by the range the sextet is in: A-Z, a-z, 0-9, '+' or '/'.
+
+ABSL_TARGET("ssse3")
+static inline __m128i SextetsToBase64Ssse3(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4,
+                                          7, 6, 8, 7, 10, 9, 11, 10));
+  const __m128i high = _mm_mulhi_epu16(
+      _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)),
+      _mm_set1_epi32(0x04000040));
+  const __m128i low = _mm_mullo_epi16(
+      _mm_and_si128(in, _mm_set1_epi32(0x003f03f0)),
+      _mm_set1_epi32(0x01000010));
+  const __m128i sextets = _mm_or_si128(high, low);
+  // 0 for a-z, 1 to 10 for 0-9, 11 for '+', 12 for '/' and 13 for A-Z.
+  __m128i range = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+  range = _mm_or_si128(range, _mm_and_si128(
+      _mm_cmplt_epi8(sextets, _mm_set1_epi8(26)), _mm_set1_epi8(13)));
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, range));
+}
+
+// Encodes 12 bytes at a time, from loads of 16.
+ABSL_TARGET("ssse3")
+static size_t Base64EncodeSsse3(string_view src, char* dest) {
+  const char* p = src.data();
+  const size_t n = src.size();
+  size_t i = 0;
+  char* out = dest;
+  for (; i + 16 <= n; i += 12, out += 16) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     SextetsToBase64Ssse3(in));
+  }
+  return (out - dest) + Base64EncodeScalar(src.substr(i), out);
+}
+
+ABSL_TARGET("avx2")
+static inline __m256i SextetsToBase64Avx2(__m256i in) {
+  in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m256i high = _mm256_mulhi_epu16(
+      _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+      _mm256_set1_epi32(0x04000040));
+  const __m256i low = _mm256_mullo_epi16(
+      _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+      _mm256_set1_epi32(0x01000010));
+  const __m256i sextets = _mm256_or_si256(high, low);
+  __m256i range = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+  range = _mm256_or_si256(range, _mm256_and_si256(
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets),
+      _mm256_set1_epi8(13)));
+  const __m256i offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, range));
+}
+
+// Encodes 24 bytes at a time, 12 in each lane from loads of 16.
+ABSL_TARGET("avx2")
+static size_t Base64EncodeAvx2(string_view src, char* dest) {
+  const char* p = src.data();
+  const size_t n = src.size();
+  size_t i = 0;
+  char* out = dest;
+  for (; i + 28 <= n; i += 24, out += 32) {
+    __m256i in = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 12)), 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                        SextetsToBase64Avx2(in));
+  }
+  return (out - dest) + Base64EncodeSsse3(src.substr(i), out);
+}
+
+#undef ABSL_TARGET
+
+#endif  // ABSL_ESCAPING_X86
+
+namespace escaping_internal {
+
+Base64Encoder GetBase64Encoder(SearchIsa isa) {
+  const CpuFeatures& cpu = GetCpuFeatures();
+  switch (isa) {
+    case SearchIsa::kScalar:
+      return Base64EncodeScalar;
+#ifdef ABSL_ESCAPING_X86
+    case SearchIsa::kSsse3:
+      return cpu.ssse3 ? Base64EncodeSsse3 : nullptr;
+    case SearchIsa::kAvx2:
+      return cpu.avx2 ? Base64EncodeAvx2 : nullptr;
+#endif
+    default:
+      (void) cpu;
+      return nullptr;
+  }
+}
+
+}  // namespace escaping_internal
+
+static escaping_internal::Base64Encoder SelectBase64Encoder() {
+  for (SearchIsa isa : {SearchIsa::kAvx2, SearchIsa::kSsse3}) {
+    auto encoder = escaping_internal::GetBase64Encoder(isa);
+    if (encoder != nullptr) { return encoder; }
+  }
+  return Base64EncodeScalar;
+}
+
+size_t Base64Encode(string_view src, char* dest) {
+  static const escaping_internal::Base64Encoder encoder =
+      SelectBase64Encoder();
+  return encoder(src, dest);
+}
+
+std::string BytesToHexString(string_view src) {
+  std::string result(HexEncodedSize(src.size()), '\0');
+  HexEncode(src, &result[0]);
+  return result;
+}
+
+std::string Base64Escape(string_view src) {
+  std::string result(Base64EncodedSize(src.size()), '\0');
+  Base64Encode(src, &result[0]);
+  return result;
+}
+
+// The size of the stack buffers the stream wrappers encode through.
+static constexpr size_t kStreamChunk = 768;
+
+std::ostream& operator<<(std::ostream& os, const HexBytes& hex) {
+  char buf[kStreamChunk];
+  string_view data = hex.data();
+  while (!data.empty()) {
+    string_view chunk = data.substr(0, sizeof(buf) / 2);
+    os.write(buf, HexEncode(chunk, buf));
+    data.remove_prefix(chunk.size());
+  }
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const Base64Bytes& base64) {
+  char buf[kStreamChunk];
+  string_view data = base64.data();
+  while (!data.empty()) {
+    // Whole groups of three bytes, so padding only ends the last chunk.
+    string_view chunk = data.substr(0, sizeof(buf) / 4 * 3);
+    os.write(buf, Base64Encode(chunk, buf));
+    data.remove_prefix(chunk.size());
+  }
+  return os;
+}
+
+// Writes one line of a hex dump into line and returns its length.
+static size_t HexDumpLine(string_view bytes, size_t offset, char* line) {
+  char* p = line;
+  for (int shift = 28; shift >= 0; shift -= 4) {
+    *p++ = kHexDigits[(offset >> shift) & 0x0f];
+  }
+  *p++ = ' ';
+  char hex[32];
+  HexEncode(bytes, hex);
+  for (size_t i = 0; i < 16; ++i) {
+    if (i == 0 || i == 8) { *p++ = ' '; }
+    if (i < bytes.size()) {
+      *p++ = hex[2 * i];
+      *p++ = hex[2 * i + 1];
+    } else {
+      *p++ = ' ';
+      *p++ = ' ';
+    }
+    *p++ = ' ';
+  }
+  *p++ = ' ';
+  *p++ = '|';
+  for (char c : bytes) { *p++ = (c >= 0x20 && c < 0x7f) ? c : '.'; }
+  *p++ = '|';
+  *p++ = '\n';
+  return p - line;
+}
+
+std::ostream& operator<<(std::ostream& os, const HexDump& dump) {
+  static const size_t kLineSize = 80;
+  char buf[kStreamChunk];
+  size_t used = 0;
+  string_view data = dump.data();
+  size_t offset = dump.base_offset();
+  while (!data.empty()) {
+    if (used + kLineSize > sizeof(buf)) {
+      os.write(buf, used);
+      used = 0;
+    }
+    string_view bytes = data.substr(0, 16);
+    used += HexDumpLine(bytes, offset, buf + used);
+    data.remove_prefix(bytes.size());
+    offset += bytes.size();
+  }
+  os.write(buf, used);
+  return os;
+}
+
+}  // namespace absl
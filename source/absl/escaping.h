@@ -0,0 +1,69 @@
+#ifndef ABSL_ESCAPING_H_
+#define ABSL_ESCAPING_H_
+
+#include "absl/char_search.h"
+#include "absl/string_view.h"
+
+namespace absl {
+
+inline size_t HexEncodedSize(size_t n) { return n * 2; }
+inline size_t Base64EncodedSize(size_t n) { return (n + 2) / 3 * 4; }
+
+// Encodes src into dest, which must have room for the encoded size. Returns
+// the number of chars written. Base64 takes SSSE3 or AVX2 where the CPU
+// has them, hex SSE2. There is no decoding: nothing reads these back.
+size_t HexEncode(string_view src, char* dest);
+size_t Base64Encode(string_view src, char* dest);
+
+std::string BytesToHexString(string_view src);
+std::string Base64Escape(string_view src);
+
+// Wrappers which stream binary data in an encoded form, e.g.
+//   LOG(INFO) << "packet " << absl::HexBytes(packet);
+// The data is encoded piecewise through a stack buffer, so no temporary
+// string is built however large the data is. The data must outlive the
+// wrapper.
+class HexBytes {
+ public:
+  explicit HexBytes(string_view data) : data_(data) { }
+  string_view data() const { return data_; }
+ private:
+  string_view data_;
+};
+
+// Lines of 16 bytes in the layout of "hexdump -C": the offset, the bytes in
+// hex and the bytes in ASCII.
+class HexDump {
+ public:
+  explicit HexDump(string_view data, size_t base_offset = 0)
+      : data_(data), base_offset_(base_offset) { }
+  string_view data() const { return data_; }
+  size_t base_offset() const { return base_offset_; }
+ private:
+  string_view data_;
+  size_t base_offset_;
+};
+
+class Base64Bytes {
+ public:
+  explicit Base64Bytes(string_view data) : data_(data) { }
+  string_view data() const { return data_; }
+ private:
+  string_view data_;
+};
+
+std::ostream& operator<<(std::ostream& os, const HexBytes& hex);
+std::ostream& operator<<(std::ostream& os, const HexDump& dump);
+std::ostream& operator<<(std::ostream& os, const Base64Bytes& base64);
+
+namespace escaping_internal {
+using Base64Encoder = size_t (*)(string_view src, char* dest);
+
+// Returns the Base64Encode of isa, or nullptr if the CPU does not support
+// it. There is no AVX-512 one.
+Base64Encoder GetBase64Encoder(search_internal::SearchIsa isa);
+}  // namespace escaping_internal
+
+}  // namespace absl
+
+#endif  // ABSL_ESCAPING_H_
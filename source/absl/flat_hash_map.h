@@ -0,0 +1,115 @@
+#ifndef ABSL_FLAT_HASH_MAP_H_
+#define ABSL_FLAT_HASH_MAP_H_
+
+#include "absl/raw_hash_set.h"
+
+namespace absl {
+namespace container_internal {
+
+// The slot holds the pair as std::pair<const K, V> for the users, and as
+// std::pair<K, V> to move the key out when the table is rehashed, instead
+// of copying it.
+template <typename K, typename V>
+struct FlatHashMapPolicy {
+  using key_type = K;
+  using value_type = std::pair<const K, V>;
+  using reference = value_type&;
+
+  union slot_type {
+    slot_type() { }
+    ~slot_type() { }
+    value_type value;
+    std::pair<K, V> mutable_value;
+  };
+
+  template <typename... Args>
+  static void construct(slot_type* slot, Args&&... args) {
+    new (&slot->value) value_type(std::forward<Args>(args)...);
+  }
+  static void destroy(slot_type* slot) { slot->value.~value_type(); }
+  static void transfer(slot_type* to, slot_type* from) {
+    new (&to->mutable_value) std::pair<K, V>(std::move(from->mutable_value));
+    from->mutable_value.~pair();
+  }
+  static const K& key(const slot_type* slot) { return slot->value.first; }
+  static value_type& element(slot_type* slot) { return slot->value; }
+};
+
+}  // namespace container_internal
+
+// An unordered map with the elements inline in one open addressing table,
+// see raw_hash_set.h. It follows std::unordered_map, except that:
+//   - rehashing moves the elements, so it invalidates pointers to them
+//     as well as iterators;
+//   - erase(iterator) returns nothing;
+//   - maps keyed by std::string are looked up by string_view or const
+//     char* without building a temporary string:
+//
+//   absl::flat_hash_map<std::string, int> ports = {{"http", 80}};
+//   auto it = ports.find(absl::string_view(line).substr(0, 4));
+template <typename K, typename V,
+          typename Hash = typename container_internal::HashEq<K>::Hash,
+          typename Eq = typename container_internal::HashEq<K>::Eq>
+class flat_hash_map : public container_internal::raw_hash_set<
+    container_internal::FlatHashMapPolicy<K, V>, Hash, Eq> {
+  using Base = container_internal::raw_hash_set<
+      container_internal::FlatHashMapPolicy<K, V>, Hash, Eq>;
+  template <typename Key>
+  using key_arg = typename container_internal::KeyArg<
+      container_internal::IsTransparent<Hash>::value &&
+      container_internal::IsTransparent<Eq>::value>::template type<Key, K>;
+
+ public:
+  using mapped_type = V;
+  using typename Base::iterator;
+  using typename Base::const_iterator;
+
+  flat_hash_map() { }
+  using Base::Base;
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    return this->LazyEmplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return this->LazyEmplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+    auto res = try_emplace(key, std::forward<M>(value));
+    if (!res.second) { res.first->second = std::forward<M>(value); }
+    return res;
+  }
+
+  // The key is converted to K only when it is inserted.
+  template <typename Key = K>
+  V& operator[](const key_arg<Key>& key) {
+    return this->LazyEmplace(key, std::piecewise_construct,
+                             std::forward_as_tuple(key),
+                             std::tuple<>()).first->second;
+  }
+  V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+  template <typename Key = K>
+  V& at(const key_arg<Key>& key) {
+    auto it = this->find(key);
+    if (it == this->end()) { throw std::out_of_range("flat_hash_map::at"); }
+    return it->second;
+  }
+  template <typename Key = K>
+  const V& at(const key_arg<Key>& key) const {
+    auto it = this->find(key);
+    if (it == this->end()) { throw std::out_of_range("flat_hash_map::at"); }
+    return it->second;
+  }
+};
+
+}  // namespace absl
+
+#endif  // ABSL_FLAT_HASH_MAP_H_
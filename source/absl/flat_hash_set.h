@@ -0,0 +1,53 @@
+#ifndef ABSL_FLAT_HASH_SET_H_
+#define ABSL_FLAT_HASH_SET_H_
+
+#include "absl/raw_hash_set.h"
+
+namespace absl {
+namespace container_internal {
+
+template <typename T>
+struct FlatHashSetPolicy {
+  using key_type = T;
+  using value_type = T;
+  using reference = const T&;
+
+  union slot_type {
+    slot_type() { }
+    ~slot_type() { }
+    T value;
+  };
+
+  template <typename... Args>
+  static void construct(slot_type* slot, Args&&... args) {
+    new (&slot->value) T(std::forward<Args>(args)...);
+  }
+  static void destroy(slot_type* slot) { slot->value.~T(); }
+  static void transfer(slot_type* to, slot_type* from) {
+    new (&to->value) T(std::move(from->value));
+    from->value.~T();
+  }
+  static const T& key(const slot_type* slot) { return slot->value; }
+  static T& element(slot_type* slot) { return slot->value; }
+};
+
+}  // namespace container_internal
+
+// An unordered set with the elements inline in one open addressing table,
+// see flat_hash_map.h for how it differs from std::unordered_set.
+template <typename T,
+          typename Hash = typename container_internal::HashEq<T>::Hash,
+          typename Eq = typename container_internal::HashEq<T>::Eq>
+class flat_hash_set : public container_internal::raw_hash_set<
+    container_internal::FlatHashSetPolicy<T>, Hash, Eq> {
+  using Base = container_internal::raw_hash_set<
+      container_internal::FlatHashSetPolicy<T>, Hash, Eq>;
+
+ public:
+  flat_hash_set() { }
+  using Base::Base;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_FLAT_HASH_SET_H_
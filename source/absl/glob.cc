@@ -0,0 +1,173 @@
+#include "absl/glob.h"
+
+#include <algorithm>
+
+namespace absl {
+
+namespace {
+constexpr size_t kMaxMaskedSize = 64;
+
+// Parses the class which starts after the '[' at pattern[*i - 1]. Returns
+// false, and leaves *i, if it has no ']'.
+bool ParseClass(string_view pattern, size_t* i, uint64_t (*bits)[4]) {
+  size_t k = *i;
+  bool negate = false;
+  if (k < pattern.size() && (pattern[k] == '!' || pattern[k] == '^')) {
+    negate = true;
+    ++k;
+  }
+  uint64_t set[4] = {};
+  auto add = [&set](unsigned char c) {
+    set[c >> 6] |= uint64_t{1} << (c & 63);
+  };
+  // A ']' right at the start is one of the bytes.
+  bool first = true;
+  while (k < pattern.size() && (pattern[k] != ']' || first)) {
+    first = false;
+    if (pattern[k] == '\\' && k + 1 < pattern.size()) { ++k; }
+    auto low = static_cast<unsigned char>(pattern[k++]);
+    unsigned char high = low;
+    if (k + 1 < pattern.size() && pattern[k] == '-' && pattern[k + 1] != ']') {
+      ++k;
+      if (pattern[k] == '\\' && k + 1 < pattern.size()) { ++k; }
+      high = static_cast<unsigned char>(pattern[k++]);
+    }
+    for (unsigned c = low; c <= high; ++c) {
+      add(static_cast<unsigned char>(c));
+    }
+  }
+  if (k >= pattern.size()) { return false; }
+  for (int w = 0; w < 4; ++w) { (*bits)[w] = negate ? ~set[w] : set[w]; }
+  *i = k + 1;
+  return true;
+}
+}  // namespace
+
+bool Glob::Segment::MatchAt(const char* p) const {
+  if (is_literal) { return memcmp(p, literal.data(), literal.size()) == 0; }
+  for (size_t k = 0; k < classes.size(); ++k) {
+    if (!classes[k].Has(static_cast<unsigned char>(p[k]))) { return false; }
+  }
+  return true;
+}
+
+size_t Glob::Segment::Find(string_view s) const {
+  if (is_literal) { return s.find(literal); }
+  const size_t m = size();
+  if (s.size() < m) { return string_view::npos; }
+  if (!masks.empty()) {
+    // Shift-And: bit k of state is set if the last k + 1 bytes match the
+    // first k + 1 classes.
+    const uint64_t accept = uint64_t{1} << (m - 1);
+    uint64_t state = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+      state = ((state << 1) | 1) & masks[static_cast<unsigned char>(s[i])];
+      if (state & accept) { return i + 1 - m; }
+    }
+    return string_view::npos;
+  }
+  for (size_t i = 0; i + m <= s.size(); ++i) {
+    if (MatchAt(s.data() + i)) { return i; }
+  }
+  return string_view::npos;
+}
+
+Glob::Glob(string_view pattern) : pattern_(pattern) {
+  segments_.emplace_back();
+  size_t i = 0;
+  while (i < pattern.size()) {
+    const char c = pattern[i++];
+    if (c == '*') {
+      if (segments_.size() == 1 || segments_.back().size() > 0) {
+        segments_.emplace_back();
+      }
+      continue;
+    }
+    Segment& segment = segments_.back();
+    ByteClass byte_class;
+    bool single = true;
+    char byte = c;
+    if (c == '?') {
+      for (uint64_t& bits : byte_class.bits) { bits = ~uint64_t{0}; }
+      single = false;
+    } else if (c == '[' && ParseClass(pattern, &i, &byte_class.bits)) {
+      single = false;
+    } else {
+      if (c == '\\' && i < pattern.size()) { byte = pattern[i++]; }
+      byte_class.Add(static_cast<unsigned char>(byte));
+    }
+    segment.classes.push_back(byte_class);
+    segment.literal.push_back(byte);
+    segment.is_literal &= single;
+  }
+  for (size_t s = 0; s < segments_.size(); ++s) {
+    Segment& segment = segments_[s];
+    min_size_ += segment.size();
+    if (!segment.is_literal) { segment.literal.clear(); }
+    // Only the segments between the first and the last are searched for.
+    const bool searched = s > 0 && s + 1 < segments_.size();
+    if (searched && !segment.is_literal &&
+        segment.size() <= kMaxMaskedSize) {
+      segment.masks.assign(256, 0);
+      for (size_t k = 0; k < segment.size(); ++k) {
+        for (unsigned c = 0; c < 256; ++c) {
+          if (segment.classes[k].Has(static_cast<unsigned char>(c))) {
+            segment.masks[c] |= uint64_t{1} << k;
+          }
+        }
+      }
+    }
+  }
+}
+
+bool Glob::Match(string_view s) const {
+  if (s.size() < min_size_) { return false; }
+  const Segment& first = segments_.front();
+  if (segments_.size() == 1) {
+    return s.size() == first.size() && first.MatchAt(s.data());
+  }
+  const Segment& last = segments_.back();
+  if (!first.MatchAt(s.data()) ||
+      !last.MatchAt(s.data() + s.size() - last.size())) {
+    return false;
+  }
+  string_view rest = s.substr(first.size(),
+                              s.size() - first.size() - last.size());
+  for (size_t k = 1; k + 1 < segments_.size(); ++k) {
+    const Segment& segment = segments_[k];
+    size_t pos = segment.Find(rest);
+    if (pos == string_view::npos) { return false; }
+    rest.remove_prefix(pos + segment.size());
+  }
+  return true;
+}
+
+size_t GlobSet::Add(string_view pattern) {
+  const size_t index = size_++;
+  Glob glob(pattern);
+  if (glob.is_literal()) {
+    literals_.try_emplace(glob.segments_[0].literal, index);
+  } else if (glob.is_prefix()) {
+    prefixes_.insert(glob.segments_[0].literal, index);
+  } else {
+    globs_.emplace_back(index, std::move(glob));
+  }
+  return index;
+}
+
+size_t GlobSet::Match(string_view s) const {
+  size_t best = npos;
+  auto it = literals_.find(s);
+  if (it != literals_.end()) { best = it->second; }
+  prefixes_.ForEachPrefixOf(s, [&best](size_t, size_t index) {
+    best = std::min(best, index);
+  });
+  // The globs are in the order of their indexes.
+  for (const auto& entry : globs_) {
+    if (entry.first >= best) { break; }
+    if (entry.second.Match(s)) { return entry.first; }
+  }
+  return best;
+}
+
+}  // namespace absl
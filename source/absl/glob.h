@@ -0,0 +1,115 @@
+#ifndef ABSL_GLOB_H_
+#define ABSL_GLOB_H_
+
+#include <vector>
+
+#include "absl/flat_hash_map.h"
+#include "absl/radix_trie.h"
+#include "absl/string_view.h"
+
+namespace absl {
+
+// A shell style wildcard pattern, compiled once and matched in time linear
+// in the length of the string, however the pattern is written.
+//
+//   absl::Glob glob("net_*.cc");
+//   if (glob.Match(file)) { ... }
+//
+// The syntax:
+//   *        any run of bytes, '/' included
+//   ?        any one byte
+//   [abc]    one of the bytes; [a-z] a range; [!a-z] or [^a-z] any other
+//   \c       the byte c itself
+// A '[' without its ']' stands for itself. Bytes are matched as they are,
+// with no notion of case or of UTF-8.
+//
+// The pattern is split at its stars into segments of fixed length. The
+// first and the last are anchored to the ends of the string, and checked
+// first. The others are found in turn, each at its leftmost place after the
+// one before, which is always the best: literal ones with
+// string_view::find, others with a bit parallel automaton.
+class Glob {
+ public:
+  explicit Glob(string_view pattern);
+
+  bool Match(string_view s) const;
+  const std::string& pattern() const { return pattern_; }
+
+ private:
+  friend class GlobSet;
+
+  // The bytes one position of a segment accepts.
+  struct ByteClass {
+    uint64_t bits[4] = {};
+    void Add(unsigned char c) { bits[c >> 6] |= uint64_t{1} << (c & 63); }
+    bool Has(unsigned char c) const { return (bits[c >> 6] >> (c & 63)) & 1; }
+  };
+
+  struct Segment {
+    size_t size() const { return classes.size(); }
+    // Whether the segment matches the size() bytes at p.
+    bool MatchAt(const char* p) const;
+    // The leftmost place in s where the segment matches, or npos.
+    size_t Find(string_view s) const;
+
+    std::vector<ByteClass> classes;
+    // The bytes, when each class holds one.
+    std::string literal;
+    bool is_literal = true;
+    // For Find on segments of up to 64 classes which are not literal: bit
+    // k of masks[c] is set if class k has c.
+    std::vector<uint64_t> masks;
+  };
+
+  bool is_literal() const {
+    return segments_.size() == 1 && segments_[0].is_literal;
+  }
+  // Whether the pattern is a literal followed by one star.
+  bool is_prefix() const {
+    return segments_.size() == 2 && segments_[0].is_literal &&
+           segments_[1].size() == 0;
+  }
+
+  std::string pattern_;
+  // The parts around the stars. Empty parts between stars are left out;
+  // the first and the last are kept, so that there are two with a star.
+  std::vector<Segment> segments_;
+  size_t min_size_ = 0;
+};
+
+// Many globs, matched at once: which of them matches a string first.
+// Literal patterns cost one hash lookup together, and patterns of one
+// trailing star, like "net_*", one walk of a trie; only the others are
+// matched one by one.
+//
+//   absl::GlobSet rules;
+//   rules.Add("*_test.cc");
+//   rules.Add("net_*");
+//   size_t rule = rules.Match(file);
+class GlobSet {
+ public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  GlobSet() { }
+  GlobSet(GlobSet&&) = default;
+  GlobSet& operator=(GlobSet&&) = default;
+
+  // Adds pattern, and returns its index, from 0 in the order they are
+  // added.
+  size_t Add(string_view pattern);
+  size_t size() const { return size_; }
+
+  // The index of the first pattern which matches s, or npos.
+  size_t Match(string_view s) const;
+
+ private:
+  // The first index of each pattern.
+  flat_hash_map<std::string, size_t> literals_;
+  RadixTrie<size_t> prefixes_;
+  std::vector<std::pair<size_t, Glob>> globs_;
+  size_t size_ = 0;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_GLOB_H_
@@ -0,0 +1,31 @@
+#include "absl/hash.h"
+
+namespace absl {
+namespace hash_internal {
+
+uint64_t HashLong(const char* p, size_t n, uint64_t seed) {
+  const size_t size = n;
+  if (n > 48) {
+    // Three independent lanes keep the multipliers busy.
+    uint64_t lane1 = seed;
+    uint64_t lane2 = seed;
+    do {
+      seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+      lane1 = Mix(Read8(p + 16) ^ kSecret[2], Read8(p + 24) ^ lane1);
+      lane2 = Mix(Read8(p + 32) ^ kSecret[3], Read8(p + 40) ^ lane2);
+      p += 48;
+      n -= 48;
+    } while (n > 48);
+    seed ^= lane1 ^ lane2;
+  }
+  while (n > 16) {
+    seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+    p += 16;
+    n -= 16;
+  }
+  // The last 16 bytes, which may overlap the bytes already mixed.
+  return Finish(Read8(p + n - 16), Read8(p + n - 8), seed, size);
+}
+
+}  // namespace hash_internal
+}  // namespace absl
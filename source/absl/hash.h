@@ -0,0 +1,127 @@
+#ifndef ABSL_HASH_H_
+#define ABSL_HASH_H_
+
+#include <cstdint>
+#include <cstring>
+
+#include "absl/string_view.h"
+
+namespace absl {
+namespace hash_internal {
+
+// The hash is wyhash: each step multiplies two 64-bit words into 128 bits
+// and folds the halves together. It is not meant to resist attacks.
+inline constexpr uint64_t kSecret[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+inline void Multiply(uint64_t* a, uint64_t* b) {
+  __uint128_t r = static_cast<__uint128_t>(*a) * *b;
+  *a = static_cast<uint64_t>(r);
+  *b = static_cast<uint64_t>(r >> 64);
+}
+
+inline uint64_t Mix(uint64_t a, uint64_t b) {
+  Multiply(&a, &b);
+  return a ^ b;
+}
+
+inline uint64_t Read8(const char* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t Read4(const char* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t Finish(uint64_t a, uint64_t b, uint64_t seed, size_t n) {
+  a ^= kSecret[1];
+  b ^= seed;
+  Multiply(&a, &b);
+  return Mix(a ^ kSecret[0] ^ n, b ^ kSecret[1]);
+}
+
+// The strings of more than 16 bytes, out of line.
+uint64_t HashLong(const char* p, size_t n, uint64_t seed);
+
+}  // namespace hash_internal
+
+// A fast, well mixed 64-bit hash of the bytes of s. Strings of up to 16
+// bytes are hashed inline, without loops.
+inline uint64_t HashOf(string_view s, uint64_t seed = 0) {
+  using hash_internal::kSecret;
+  using hash_internal::Mix;
+  using hash_internal::Read4;
+  const char* p = s.data();
+  const size_t n = s.size();
+  seed ^= Mix(seed ^ kSecret[0], kSecret[1]);
+  if (n > 16) { return hash_internal::HashLong(p, n, seed); }
+  uint64_t a = 0;
+  uint64_t b = 0;
+  if (n >= 4) {
+    // Two overlapping pairs of 4-byte loads cover 4 to 16 bytes.
+    const size_t step = (n >> 3) << 2;
+    a = (Read4(p) << 32) | Read4(p + step);
+    b = (Read4(p + n - 4) << 32) | Read4(p + n - 4 - step);
+  } else if (n > 0) {
+    auto byte = [p](size_t i) {
+      return static_cast<uint64_t>(static_cast<unsigned char>(p[i]));
+    };
+    a = (byte(0) << 16) | (byte(n >> 1) << 8) | byte(n - 1);
+  }
+  return hash_internal::Finish(a, b, seed, n);
+}
+
+// Scrambles an integer, so that its low bits depend on all of its bits.
+inline uint64_t HashInt(uint64_t v) {
+  return hash_internal::Mix(v ^ hash_internal::kSecret[0],
+                            hash_internal::kSecret[1]);
+}
+
+// The hash functor of the absl containers. Strings and string views hash
+// the same, so containers keyed by strings can be looked up with views;
+// the string functors are transparent for that. Other types take their
+// std::hash scrambled by HashInt, since std::hash of integers and pointers
+// is often the identity.
+template <typename T>
+struct Hash {
+  size_t operator()(const T& v) const {
+    return static_cast<size_t>(HashInt(std::hash<T>()(v)));
+  }
+};
+
+struct StringHash {
+  using is_transparent = void;
+  size_t operator()(string_view s) const {
+    return static_cast<size_t>(HashOf(s));
+  }
+};
+
+struct StringEq {
+  using is_transparent = void;
+  bool operator()(string_view a, string_view b) const { return a == b; }
+};
+
+template <>
+struct Hash<string_view> : StringHash { };
+template <>
+struct Hash<std::string> : StringHash { };
+
+}  // namespace absl
+
+namespace std {
+
+template <>
+struct hash<absl::string_view> {
+  size_t operator()(absl::string_view s) const {
+    return static_cast<size_t>(absl::HashOf(s));
+  }
+};
+
+}  // namespace std
+
+#endif  // ABSL_HASH_H_
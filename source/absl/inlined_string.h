@@ -0,0 +1,172 @@
+#ifndef ABSL_INLINED_STRING_H_
+#define ABSL_INLINED_STRING_H_
+
+#include <algorithm>
+#include <cstring>
+
+#include "absl/string_view.h"
+
+namespace absl {
+
+// A string which keeps up to N chars in the object itself, and only goes to
+// the heap beyond that, for the short strings of hot paths, e.g. thread
+// names or tags, which std::string would not all keep inline.
+//
+//   absl::InlinedString<15> tid(FormatTid());
+//   absl::string_view view = tid;
+//
+// The chars are always followed by a NUL.
+template <size_t N>
+class InlinedString {
+ public:
+  static constexpr size_t kInlineCapacity = N;
+
+  InlinedString() { inline_[0] = '\0'; }
+  // Not from const char* as well, which would make comparisons with
+  // literals ambiguous: InlinedString<N> s("text") initializes directly.
+  InlinedString(string_view s) : InlinedString() { append(s); }
+  InlinedString(const InlinedString& other) : InlinedString() {
+    append(other);
+  }
+  InlinedString(InlinedString&& other) noexcept : InlinedString() {
+    MoveFrom(&other);
+  }
+  ~InlinedString() { ReleaseHeap(); }
+
+  InlinedString& operator=(const InlinedString& other) {
+    if (this != &other) { assign(other); }
+    return *this;
+  }
+  InlinedString& operator=(InlinedString&& other) noexcept {
+    if (this != &other) {
+      ReleaseHeap();
+      capacity_ = N;
+      MoveFrom(&other);
+    }
+    return *this;
+  }
+  InlinedString& operator=(string_view s) {
+    assign(s);
+    return *this;
+  }
+
+  const char* data() const { return inlined() ? inline_ : heap_; }
+  char* data() { return inlined() ? inline_ : heap_; }
+  const char* c_str() const { return data(); }
+  size_t size() const { return size_; }
+  size_t length() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return capacity_; }
+  // Whether the chars are in the object.
+  bool inlined() const { return capacity_ == N; }
+
+  char operator[](size_t i) const { return data()[i]; }
+  char& operator[](size_t i) { return data()[i]; }
+  operator string_view() const { return string_view(data(), size_); }
+
+  void clear() { Truncate(0); }
+  void assign(string_view s) {
+    if (s.size() <= capacity_) {
+      // s may be a part of this string.
+      memmove(data(), s.data(), s.size());
+      Truncate(s.size());
+    } else {
+      clear();
+      append(s);
+    }
+  }
+  void append(string_view s) {
+    size_t size = size_ + s.size();
+    if (size > capacity_) {
+      Grow(size, s);
+    } else {
+      memmove(data() + size_, s.data(), s.size());
+    }
+    Truncate(size);
+  }
+  void push_back(char c) { append(string_view(&c, 1)); }
+  InlinedString& operator+=(string_view s) {
+    append(s);
+    return *this;
+  }
+  void reserve(size_t n) {
+    if (n > capacity_) { Grow(n, string_view()); }
+  }
+  // Chars beyond the current size are NULs.
+  void resize(size_t n) {
+    reserve(n);
+    if (n > size_) { memset(data() + size_, 0, n - size_); }
+    Truncate(n);
+  }
+
+  friend bool operator==(const InlinedString& a, const InlinedString& b) {
+    return string_view(a) == string_view(b);
+  }
+  friend bool operator==(const InlinedString& a, string_view b) {
+    return string_view(a) == b;
+  }
+  friend bool operator==(string_view a, const InlinedString& b) {
+    return a == string_view(b);
+  }
+  friend bool operator!=(const InlinedString& a, const InlinedString& b) {
+    return !(a == b);
+  }
+  friend bool operator!=(const InlinedString& a, string_view b) {
+    return !(a == b);
+  }
+  friend bool operator!=(string_view a, const InlinedString& b) {
+    return !(a == b);
+  }
+  friend bool operator<(const InlinedString& a, const InlinedString& b) {
+    return string_view(a) < string_view(b);
+  }
+
+ private:
+  void Truncate(size_t n) {
+    size_ = n;
+    data()[n] = '\0';
+  }
+
+  // Moves the chars to a heap buffer of at least n chars, with tail, which
+  // may point into the old buffer, appended.
+  void Grow(size_t n, string_view tail) {
+    size_t capacity = std::max(n, 2 * capacity_);
+    char* heap = new char[capacity + 1];
+    memcpy(heap, data(), size_);
+    memcpy(heap + size_, tail.data(), tail.size());
+    ReleaseHeap();
+    heap_ = heap;
+    capacity_ = capacity;
+  }
+
+  void ReleaseHeap() {
+    if (!inlined()) { delete[] heap_; }
+  }
+
+  // Takes the heap buffer of other, or copies its inline chars. Leaves other
+  // empty.
+  void MoveFrom(InlinedString* other) {
+    if (other->inlined()) {
+      memcpy(inline_, other->inline_, other->size_ + 1);
+      size_ = other->size_;
+    } else {
+      heap_ = other->heap_;
+      size_ = other->size_;
+      capacity_ = other->capacity_;
+      other->capacity_ = N;
+    }
+    other->Truncate(0);
+  }
+
+  size_t size_ = 0;
+  // N while the chars are inline, the size of the heap buffer beyond.
+  size_t capacity_ = N;
+  union {
+    char inline_[N + 1];
+    char* heap_;
+  };
+};
+
+}  // namespace absl
+
+#endif  // ABSL_INLINED_STRING_H_
@@ -0,0 +1,111 @@
+#include "absl/multi_matcher.h"
+
+namespace absl {
+
+// The vectorized skip pays off while the bytes which start patterns are
+// rare in the text, which gets unlikely as they grow in number.
+static constexpr size_t kMaxPrefilterBytes = 16;
+
+MultiMatcher::MultiMatcher(const std::vector<string_view>& patterns)
+    : first_bytes_(string_view()) {
+  bool used[256] = {};
+  size_t used_count = 0;
+  for (auto pattern : patterns) {
+    for (char c : pattern) {
+      auto b = static_cast<unsigned char>(c);
+      if (!used[b]) {
+        used[b] = true;
+        ++used_count;
+      }
+    }
+  }
+  class_count_ = used_count == 256 ? 0 : 1;
+  for (int b = 0; b < 256; ++b) {
+    classes_[b] = used[b] ? static_cast<uint8_t>(class_count_++) : 0;
+  }
+
+  // The trie of the patterns.
+  delta_.assign(class_count_, kNone);
+  first_pattern_.assign(1, kNone);
+  next_pattern_.assign(patterns.size(), kNone);
+  string first_bytes;
+  for (size_t k = 0; k < patterns.size(); ++k) {
+    string_view pattern = patterns[k];
+    pattern_sizes_.push_back(pattern.size());
+    if (pattern.empty()) { continue; }
+    if (first_bytes.find(pattern.front()) == string::npos) {
+      first_bytes.push_back(pattern.front());
+    }
+    uint32_t state = kRoot;
+    for (char c : pattern) {
+      auto& next = delta_[state * class_count_ +
+                          classes_[static_cast<unsigned char>(c)]];
+      if (next == kNone) {
+        next = static_cast<uint32_t>(first_pattern_.size());
+        first_pattern_.push_back(kNone);
+        delta_.resize(delta_.size() + class_count_, kNone);
+      }
+      // The resize may have moved next.
+      state = delta_[state * class_count_ +
+                     classes_[static_cast<unsigned char>(c)]];
+    }
+    uint32_t* last = &first_pattern_[state];
+    while (*last != kNone) { last = &next_pattern_[*last]; }
+    *last = static_cast<uint32_t>(k);
+  }
+  use_prefilter_ = !first_bytes.empty() &&
+                   first_bytes.size() <= kMaxPrefilterBytes;
+  first_bytes_ = search_internal::CharSet(first_bytes);
+
+  // Breadth first, the failure links of a state are done before the state,
+  // so the missing transitions of a state are copied from its failure link.
+  const size_t state_count = first_pattern_.size();
+  std::vector<uint32_t> failure(state_count, kRoot);
+  output_.assign(state_count, kNone);
+  output_link_.assign(state_count, kNone);
+  std::vector<uint32_t> queue;
+  queue.reserve(state_count);
+  for (size_t c = 0; c < class_count_; ++c) {
+    uint32_t& next = delta_[c];
+    if (next == kNone) {
+      next = kRoot;
+    } else {
+      queue.push_back(next);
+    }
+  }
+  for (size_t head = 0; head < queue.size(); ++head) {
+    uint32_t state = queue[head];
+    output_link_[state] = output_[failure[state]];
+    output_[state] = first_pattern_[state] != kNone
+        ? state : output_link_[state];
+    const uint32_t* fallback = &delta_[failure[state] * class_count_];
+    uint32_t* row = &delta_[state * class_count_];
+    for (size_t c = 0; c < class_count_; ++c) {
+      if (row[c] == kNone) {
+        row[c] = fallback[c];
+      } else {
+        failure[row[c]] = fallback[c];
+        queue.push_back(row[c]);
+      }
+    }
+  }
+}
+
+bool MultiMatcher::FindFirst(string_view text, Match* match) const {
+  bool found = false;
+  ForEachMatch(text, [&](const Match& m) {
+    *match = m;
+    found = true;
+    return false;
+  });
+  return found;
+}
+
+std::vector<MultiMatcher::Match> MultiMatcher::FindAll(
+    string_view text) const {
+  std::vector<Match> matches;
+  ForEachMatch(text, [&](const Match& m) { matches.push_back(m); });
+  return matches;
+}
+
+}  // namespace absl
@@ -0,0 +1,121 @@
+#ifndef ABSL_MULTI_MATCHER_H_
+#define ABSL_MULTI_MATCHER_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/char_search.h"
+#include "absl/string_view.h"
+
+namespace absl {
+
+// A set of patterns searched for all at once, in a single pass over the
+// text, with an Aho-Corasick automaton. The cost of a search hardly depends
+// on the number of patterns.
+//
+//   absl::MultiMatcher matcher({"error", "timeout", "refused"});
+//   matcher.ForEachMatch(line, [](const absl::MultiMatcher::Match& m) {
+//     ...
+//   });
+//
+// Matches are reported in the order of their ends in the text, and matches
+// which end at the same byte from the longest to the shortest. Empty
+// patterns never match.
+class MultiMatcher {
+ public:
+  struct Match {
+    // The index of the pattern in the list the matcher was built from.
+    size_t pattern;
+    // The start of the match in the text.
+    size_t position;
+  };
+
+  explicit MultiMatcher(const std::vector<string_view>& patterns);
+  MultiMatcher(std::initializer_list<string_view> patterns)
+      : MultiMatcher(std::vector<string_view>(patterns)) { }
+
+  size_t pattern_count() const { return pattern_sizes_.size(); }
+
+  // Finds the match which ends first. Returns false if there is none.
+  bool FindFirst(string_view text, Match* match) const;
+  bool Contains(string_view text) const {
+    Match match;
+    return FindFirst(text, &match);
+  }
+  std::vector<Match> FindAll(string_view text) const;
+
+  // Calls f(const Match&) for every match; f returns void, or a bool which
+  // stops the search when false.
+  template <typename F>
+  void ForEachMatch(string_view text, F f) const;
+
+ private:
+  static constexpr uint32_t kNone = 0xffffffff;
+  static constexpr uint32_t kRoot = 0;
+
+  template <typename F>
+  static bool Call(F& f, const Match& match, std::true_type) {
+    return f(match);
+  }
+  template <typename F>
+  static bool Call(F& f, const Match& match, std::false_type) {
+    f(match);
+    return true;
+  }
+
+  // Bytes which occur in no pattern share class 0, the others get a class
+  // each, so the rows of the transition table are as short as possible.
+  uint8_t classes_[256];
+  size_t class_count_ = 1;
+  // The transitions of state s are at delta_[s * class_count_].
+  std::vector<uint32_t> delta_;
+  // The nearest state along the failure links, s itself included, at which
+  // patterns end, or kNone.
+  std::vector<uint32_t> output_;
+  // The first pattern which ends at a state, and the next one which ends
+  // at the same state, for duplicated patterns.
+  std::vector<uint32_t> first_pattern_;
+  std::vector<uint32_t> next_pattern_;
+  // The nearest state with patterns along the failure links of a state
+  // with patterns, excluding the state itself.
+  std::vector<uint32_t> output_link_;
+  std::vector<size_t> pattern_sizes_;
+  // The bytes which start patterns, to skip text from the root state with a
+  // vectorized scan. Only used when they are few.
+  search_internal::CharSet first_bytes_;
+  bool use_prefilter_ = false;
+};
+
+template <typename F>
+void MultiMatcher::ForEachMatch(string_view text, F f) const {
+  using ReturnsBool = std::is_same<decltype(f(std::declval<const Match&>())),
+                                   bool>;
+  const auto& kernels = search_internal::GetSearchKernels();
+  const char* p = text.data();
+  const size_t n = text.size();
+  uint32_t state = kRoot;
+  size_t i = 0;
+  while (i < n) {
+    if (state == kRoot && use_prefilter_) {
+      size_t skip = kernels.find_first_of(p + i, n - i, first_bytes_, false);
+      if (skip == string_view::npos) { return; }
+      i += skip;
+    }
+    state = delta_[state * class_count_ +
+                   classes_[static_cast<unsigned char>(p[i])]];
+    ++i;
+    for (uint32_t s = output_[state]; s != kNone; s = output_link_[s]) {
+      for (uint32_t k = first_pattern_[s]; k != kNone; k = next_pattern_[k]) {
+        Match match{k, i - pattern_sizes_[k]};
+        if (!Call(f, match, ReturnsBool())) { return; }
+      }
+    }
+  }
+}
+
+}  // namespace absl
+
+#endif  // ABSL_MULTI_MATCHER_H_
@@ -0,0 +1,217 @@
+#include "absl/numbers.h"
+
+#include <charconv>
+
+namespace absl {
+
+namespace {
+constexpr uint64_t kZeros = 0x3030303030303030ULL;
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool IsSpace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+string_view StripSpaces(string_view s) {
+  while (!s.empty() && IsSpace(s.front())) { s.remove_prefix(1); }
+  while (!s.empty() && IsSpace(s.back())) { s.remove_suffix(1); }
+  return s;
+}
+
+// Whether the 8 bytes of v, in memory order, are all digits: their high
+// nibbles are 3, and adding 6 to each byte does not carry out of its low
+// nibble.
+inline bool IsEightDigits(uint64_t v) {
+  return (v & 0xf0f0f0f0f0f0f0f0ULL) == kZeros &&
+         ((v + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL) == kZeros;
+}
+
+// The value of 8 digits, combined pairwise into 2, 4 and 8 digit numbers
+// with three multiplications.
+inline uint64_t ParseEightDigits(uint64_t v) {
+  v = ((v & 0x0f0f0f0f0f0f0f0fULL) * 2561) >> 8;
+  v = ((v & 0x00ff00ff00ff00ffULL) * 6553601) >> 16;
+  return ((v & 0x0000ffff0000ffffULL) * 42949672960001ULL) >> 32;
+}
+
+// No 19 digit number overflows 64 bits.
+constexpr int kMaxSafeDigits = 19;
+
+// Adds the digits from p on to *value, as long as their count stays safe.
+// Returns the end of the digits consumed.
+const char* ConsumeDigits(const char* p, const char* end, uint64_t* value,
+                          int* count) {
+  uint64_t v = *value;
+  int n = *count;
+  while (end - p >= 8 && n + 8 <= kMaxSafeDigits) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    if (!IsEightDigits(word)) { break; }
+    v = v * 100000000 + ParseEightDigits(word);
+    p += 8;
+    n += 8;
+  }
+  while (p < end && IsDigit(*p) && n < kMaxSafeDigits) {
+    v = v * 10 + (*p - '0');
+    ++p;
+    ++n;
+  }
+  *value = v;
+  *count = n;
+  return p;
+}
+
+constexpr double kPowersOf10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Clinger's fast path: a mantissa of at most 53 bits and a power of ten up
+// to 10^22 are both exact doubles, so one multiplication or division rounds
+// correctly. Returns false for the other numbers.
+bool ParseFast(string_view s, double* out) {
+  const char* p = s.begin();
+  const char* end = s.end();
+  bool negative = false;
+  if (p < end && *p == '-') {
+    negative = true;
+    ++p;
+  }
+  uint64_t mantissa = 0;
+  int digits = 0;
+  const char* int_end = ConsumeDigits(p, end, &mantissa, &digits);
+  int exponent = 0;
+  const char* q = int_end;
+  if (q < end && *q == '.') {
+    const char* frac = q + 1;
+    q = ConsumeDigits(frac, end, &mantissa, &digits);
+    exponent -= static_cast<int>(q - frac);
+  }
+  if (digits == 0 || (q < end && IsDigit(*q))) { return false; }
+  if (q < end && (*q == 'e' || *q == 'E')) {
+    ++q;
+    bool negative_exponent = false;
+    if (q < end && (*q == '-' || *q == '+')) {
+      negative_exponent = *q == '-';
+      ++q;
+    }
+    if (q == end || end - q > 3) { return false; }
+    int e = 0;
+    for (; q < end; ++q) {
+      if (!IsDigit(*q)) { return false; }
+      e = e * 10 + (*q - '0');
+    }
+    exponent += negative_exponent ? -e : e;
+  }
+  if (q != end || mantissa > (uint64_t{1} << 53) || exponent < -22 ||
+      exponent > 22) {
+    return false;
+  }
+  double value = static_cast<double>(mantissa);
+  value = exponent < 0 ? value / kPowersOf10[-exponent]
+                       : value * kPowersOf10[exponent];
+  *out = negative ? -value : value;
+  return true;
+}
+
+// Whether the out of range number in s is too large, rather than too
+// small: its first significant digit is left of the point after applying
+// the exponent.
+bool IsOverflow(string_view s) {
+  long position = 0;
+  bool seen_point = false;
+  bool seen_digit = false;
+  size_t i = 0;
+  for (; i < s.size() && s[i] != 'e' && s[i] != 'E'; ++i) {
+    if (s[i] == '.') {
+      seen_point = true;
+    } else if (IsDigit(s[i])) {
+      if (!seen_digit && s[i] != '0') {
+        seen_digit = true;
+      } else if (!seen_digit && seen_point) {
+        --position;
+      }
+      if (seen_digit && !seen_point) { ++position; }
+    }
+  }
+  long exponent = 0;
+  if (i < s.size()) {
+    // The number parsed, so the exponent is well formed; clamp it.
+    bool negative = s[i + 1] == '-';
+    for (++i; i < s.size(); ++i) {
+      if (IsDigit(s[i]) && exponent < 100000) {
+        exponent = exponent * 10 + (s[i] - '0');
+      }
+    }
+    if (negative) { exponent = -exponent; }
+  }
+  return position + exponent > 0;
+}
+
+template <typename Float>
+bool ParseFloat(string_view s, Float* out) {
+  s = StripSpaces(s);
+  // from_chars takes no plus sign.
+  if (!s.empty() && s.front() == '+') {
+    s.remove_prefix(1);
+    if (!s.empty() && s.front() == '-') { return false; }
+  }
+  if (s.empty()) { return false; }
+  if (std::is_same<Float, double>::value) {
+    double fast;
+    if (ParseFast(s, &fast)) {
+      *out = static_cast<Float>(fast);
+      return true;
+    }
+  }
+  // The slow path of libstdc++ rounds correctly with the Eisel-Lemire
+  // algorithm, and falls back to big decimals for the hard cases.
+  Float value;
+  auto res = std::from_chars(s.begin(), s.end(), value);
+  if (res.ptr != s.end()) { return false; }
+  if (res.ec == std::errc::result_out_of_range) {
+    if (IsOverflow(s)) { return false; }
+    value = s.front() == '-' ? -Float(0) : Float(0);
+  } else if (res.ec != std::errc()) {
+    return false;
+  }
+  *out = value;
+  return true;
+}
+}  // namespace
+
+namespace numbers_internal {
+
+bool ParseDecimal(string_view s, uint64_t* magnitude, bool* negative) {
+  s = StripSpaces(s);
+  *negative = false;
+  if (!s.empty() && (s.front() == '-' || s.front() == '+')) {
+    *negative = s.front() == '-';
+    s.remove_prefix(1);
+  }
+  if (s.empty()) { return false; }
+  const char* p = s.begin();
+  const char* end = s.end();
+  uint64_t value = 0;
+  int digits = 0;
+  p = ConsumeDigits(p, end, &value, &digits);
+  // Beyond 19 digits, e.g. with leading zeros, each digit may overflow.
+  for (; p < end && IsDigit(*p); ++p) {
+    if (__builtin_mul_overflow(value, 10, &value) ||
+        __builtin_add_overflow(value, static_cast<uint64_t>(*p - '0'),
+                               &value)) {
+      return false;
+    }
+  }
+  if (p != end) { return false; }
+  *magnitude = value;
+  return true;
+}
+
+}  // namespace numbers_internal
+
+bool SimpleAtod(string_view s, double* out) { return ParseFloat(s, out); }
+
+bool SimpleAtof(string_view s, float* out) { return ParseFloat(s, out); }
+
+}  // namespace absl
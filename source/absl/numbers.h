@@ -0,0 +1,56 @@
+#ifndef ABSL_NUMBERS_H_
+#define ABSL_NUMBERS_H_
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "absl/string_view.h"
+
+namespace absl {
+
+namespace numbers_internal {
+// Parses the decimal integer in s, with an optional sign, into its
+// magnitude and sign. Returns false if s holds anything else or the
+// magnitude does not fit in 64 bits.
+bool ParseDecimal(string_view s, uint64_t* magnitude, bool* negative);
+}  // namespace numbers_internal
+
+// Parses s as a decimal integer, with an optional sign and surrounding
+// ASCII whitespace. Returns false, with *out unchanged, if s holds anything
+// else or the value does not fit in Int. The parsing ignores the locale,
+// and takes 8 digits at a time.
+template <typename Int>
+bool SimpleAtoi(string_view s, Int* out) {
+  static_assert(std::is_integral<Int>::value &&
+                    !std::is_same<Int, bool>::value,
+                "SimpleAtoi parses integers");
+  uint64_t magnitude;
+  bool negative;
+  if (!numbers_internal::ParseDecimal(s, &magnitude, &negative)) {
+    return false;
+  }
+  using Limits = std::numeric_limits<Int>;
+  if (negative) {
+    if (!Limits::is_signed && magnitude != 0) { return false; }
+    // The magnitude of the minimum is one more than the maximum.
+    if (magnitude > static_cast<uint64_t>(Limits::max()) + 1) { return false; }
+    *out = static_cast<Int>(0 - magnitude);
+  } else {
+    if (magnitude > static_cast<uint64_t>(Limits::max())) { return false; }
+    *out = static_cast<Int>(magnitude);
+  }
+  return true;
+}
+
+// Parses s as a floating point number in the forms of strtod, with
+// surrounding ASCII whitespace but without hex floats, into the nearest
+// double or float. Returns false, with *out unchanged, if s holds anything
+// else or the value overflows. Values which underflow round to zero. The
+// parsing ignores the locale.
+bool SimpleAtod(string_view s, double* out);
+bool SimpleAtof(string_view s, float* out);
+
+}  // namespace absl
+
+#endif  // ABSL_NUMBERS_H_
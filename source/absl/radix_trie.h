@@ -0,0 +1,290 @@
+#ifndef ABSL_RADIX_TRIE_H_
+#define ABSL_RADIX_TRIE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "absl/string_view.h"
+
+namespace absl {
+
+// A map from strings to values for prefix queries: exact lookups, the
+// longest key which prefixes a text, and the keys under a prefix, all in
+// time proportional to the length of the key or text, however many keys
+// there are.
+//
+//   absl::RadixTrie<Handler> routes;
+//   routes.insert("/api/", api_handler);
+//   routes.insert("/api/users/", users_handler);
+//   size_t length;
+//   const Handler* h = routes.LongestPrefix("/api/users/42", &length);
+//
+// Runs of bytes without branches are kept in one node. A node with up to 8
+// children keeps their first bytes in a word, matched all at once, and the
+// pointers in one cache line; more children take a table of 256.
+template <typename V>
+class RadixTrie {
+ public:
+  RadixTrie() : root_(new Node(string_view())) { }
+  ~RadixTrie() { delete root_; }
+  RadixTrie(RadixTrie&& other) noexcept
+      : root_(other.root_), size_(other.size_) {
+    other.root_ = new Node(string_view());
+    other.size_ = 0;
+  }
+  RadixTrie& operator=(RadixTrie&& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+  RadixTrie(const RadixTrie&) = delete;
+  RadixTrie& operator=(const RadixTrie&) = delete;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  void clear() { *this = RadixTrie(); }
+
+  // Inserts value at key, unless key is there already. Returns the value at
+  // key and whether it was inserted.
+  std::pair<V*, bool> insert(string_view key, V value) {
+    Node* node = FindOrCreate(key);
+    if (node->value) { return {&*node->value, false}; }
+    node->value.emplace(std::move(value));
+    ++size_;
+    return {&*node->value, true};
+  }
+  V& operator[](string_view key) { return *insert(key, V()).first; }
+
+  const V* find(string_view key) const {
+    const Node* node = root_;
+    size_t i = 0;
+    while (true) {
+      string_view label(node->label);
+      if (key.substr(i, label.size()) != label) { return nullptr; }
+      i += label.size();
+      if (i == key.size()) { return node->value ? &*node->value : nullptr; }
+      Node* const* child =
+          node->Child(static_cast<unsigned char>(key[i++]));
+      if (child == nullptr) { return nullptr; }
+      node = *child;
+    }
+  }
+  V* find(string_view key) {
+    return const_cast<V*>(static_cast<const RadixTrie*>(this)->find(key));
+  }
+  bool contains(string_view key) const { return find(key) != nullptr; }
+
+  // The value of the longest key which is a prefix of text, or nullptr if
+  // there is none. The length of the key goes to *length.
+  const V* LongestPrefix(string_view text, size_t* length = nullptr) const {
+    const V* best = nullptr;
+    size_t best_length = 0;
+    const Node* node = root_;
+    size_t i = 0;
+    while (true) {
+      string_view label(node->label);
+      if (text.substr(i, label.size()) != label) { break; }
+      i += label.size();
+      if (node->value) {
+        best = &*node->value;
+        best_length = i;
+      }
+      if (i == text.size()) { break; }
+      Node* const* child =
+          node->Child(static_cast<unsigned char>(text[i++]));
+      if (child == nullptr) { break; }
+      node = *child;
+    }
+    if (length != nullptr) { *length = best_length; }
+    return best;
+  }
+
+  // Calls f(size_t length, const V& value) for the keys which are prefixes
+  // of text, shortest first.
+  template <typename F>
+  void ForEachPrefixOf(string_view text, F f) const {
+    const Node* node = root_;
+    size_t i = 0;
+    while (true) {
+      string_view label(node->label);
+      if (text.substr(i, label.size()) != label) { return; }
+      i += label.size();
+      if (node->value) { f(i, *node->value); }
+      if (i == text.size()) { return; }
+      Node* const* child =
+          node->Child(static_cast<unsigned char>(text[i++]));
+      if (child == nullptr) { return; }
+      node = *child;
+    }
+  }
+
+  // Calls f(string_view key, const V& value) for the keys which start with
+  // prefix, in byte order. The key view only lives for the call.
+  template <typename F>
+  void ForEachWithPrefix(string_view prefix, F f) const {
+    const Node* node = root_;
+    size_t i = 0;
+    while (true) {
+      string_view label(node->label);
+      string_view rest = prefix.substr(i);
+      if (rest.size() <= label.size()) {
+        if (!label.starts_with(rest)) { return; }
+        std::string key(prefix.data(), i);
+        key.append(node->label);
+        Walk(node, &key, f);
+        return;
+      }
+      if (!rest.starts_with(label)) { return; }
+      i += label.size();
+      Node* const* child =
+          node->Child(static_cast<unsigned char>(prefix[i++]));
+      if (child == nullptr) { return; }
+      node = *child;
+    }
+  }
+  template <typename F>
+  void ForEach(F f) const { ForEachWithPrefix(string_view(), f); }
+
+ private:
+  static constexpr int kSmallSize = 8;
+  static constexpr uint64_t kOnes = 0x0101010101010101ULL;
+  static constexpr uint64_t kHighs = 0x8080808080808080ULL;
+
+  struct Node {
+    explicit Node(string_view l) : label(l.data(), l.size()) { }
+    ~Node() {
+      if (large) {
+        for (int b = 0; b < 256; ++b) { delete table[b]; }
+        delete[] table;
+      } else {
+        for (int k = 0; k < child_count; ++k) { delete small[k]; }
+      }
+    }
+
+    // The slot of the child whose edge starts with byte, or nullptr.
+    Node* const* Child(unsigned char byte) const {
+      if (large) { return table[byte] != nullptr ? &table[byte] : nullptr; }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      // Finds byte among the keys in one go. Only bytes above a match can
+      // be flagged falsely, and the keys are unique.
+      uint64_t word;
+      memcpy(&word, keys, sizeof(word));
+      uint64_t x = word ^ (kOnes * byte);
+      uint64_t match = (x - kOnes) & ~x & kHighs;
+      if (child_count < kSmallSize) {
+        match &= (uint64_t{1} << (8 * child_count)) - 1;
+      }
+      if (match == 0) { return nullptr; }
+      return &small[__builtin_ctzll(match) >> 3];
+#else
+      for (int k = 0; k < child_count; ++k) {
+        if (keys[k] == byte) { return &small[k]; }
+      }
+      return nullptr;
+#endif
+    }
+    Node** Child(unsigned char byte) {
+      return const_cast<Node**>(static_cast<const Node*>(this)->Child(byte));
+    }
+
+    void AddChild(unsigned char byte, Node* child) {
+      if (!large && child_count == kSmallSize) {
+        Node** children = new Node*[256]();
+        for (int k = 0; k < kSmallSize; ++k) {
+          children[keys[k]] = small[k];
+        }
+        table = children;
+        large = true;
+      }
+      if (large) {
+        table[byte] = child;
+      } else {
+        // The keys stay sorted, for iteration in order.
+        int k = child_count;
+        for (; k > 0 && keys[k - 1] > byte; --k) {
+          keys[k] = keys[k - 1];
+          small[k] = small[k - 1];
+        }
+        keys[k] = byte;
+        small[k] = child;
+      }
+      ++child_count;
+    }
+
+    // The bytes from the one which selects this node to the next branch.
+    std::string label;
+    std::optional<V> value;
+    uint16_t child_count = 0;
+    bool large = false;
+    uint8_t keys[kSmallSize] = {};
+    union {
+      Node* small[kSmallSize];
+      Node** table;
+    };
+  };
+
+  Node* FindOrCreate(string_view key) {
+    Node** slot = &root_;
+    size_t i = 0;
+    while (true) {
+      Node* node = *slot;
+      string_view label(node->label);
+      string_view rest = key.substr(i);
+      size_t common = 0;
+      size_t limit = std::min(label.size(), rest.size());
+      while (common < limit && label[common] == rest[common]) { ++common; }
+      if (common < label.size()) {
+        // A new node takes the common part of the label and the old node
+        // the rest, after the byte which now selects it.
+        Node* middle = new Node(label.substr(0, common));
+        auto byte = static_cast<unsigned char>(label[common]);
+        node->label.erase(0, common + 1);
+        middle->AddChild(byte, node);
+        *slot = middle;
+        node = middle;
+      }
+      i += common;
+      if (i == key.size()) { return node; }
+      auto byte = static_cast<unsigned char>(key[i]);
+      Node** child = node->Child(byte);
+      if (child == nullptr) {
+        Node* leaf = new Node(key.substr(i + 1));
+        node->AddChild(byte, leaf);
+        return leaf;
+      }
+      slot = child;
+      ++i;
+    }
+  }
+
+  template <typename F>
+  static void Walk(const Node* node, std::string* key, F& f) {
+    if (node->value) { f(string_view(*key), *node->value); }
+    size_t size = key->size();
+    auto visit = [key, size, &f](unsigned char byte, const Node* child) {
+      key->push_back(static_cast<char>(byte));
+      key->append(child->label);
+      Walk(child, key, f);
+      key->resize(size);
+    };
+    if (node->large) {
+      for (int b = 0; b < 256; ++b) {
+        if (node->table[b] != nullptr) { visit(b, node->table[b]); }
+      }
+    } else {
+      for (int k = 0; k < node->child_count; ++k) {
+        visit(node->keys[k], node->small[k]);
+      }
+    }
+  }
+
+  Node* root_;
+  size_t size_ = 0;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_RADIX_TRIE_H_
@@ -0,0 +1,615 @@
+#ifndef ABSL_RAW_HASH_SET_H_
+#define ABSL_RAW_HASH_SET_H_
+
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "absl/hash.h"
+#include "absl/string_view.h"
+
+namespace absl {
+namespace container_internal {
+
+// The open addressing table behind flat_hash_map and flat_hash_set, after
+// the Swiss tables of Abseil.
+//
+// The elements live in one array of slots. A parallel array holds a control
+// byte per slot: kEmpty, kDeleted, or for a full slot the low 7 bits of the
+// hash of its element (H2). A lookup starts at a slot picked by the other
+// bits of the hash (H1), loads the control bytes of the 16 slots from there
+// at once, and compares only the elements whose H2 matches, which rarely
+// fails. The probe moves on by growing steps of 16 slots until it meets an
+// empty slot.
+//
+// The control array ends with a sentinel, which stops iteration, and a copy
+// of its first 15 bytes, so a group can be loaded at any slot without
+// wrapping around.
+using ctrl_t = signed char;
+
+enum Ctrl : ctrl_t {
+  kEmpty = -128,
+  kDeleted = -2,
+  kSentinel = -1,
+};
+
+inline bool IsFull(ctrl_t c) { return c >= 0; }
+inline bool IsEmptyOrDeleted(ctrl_t c) { return c < kSentinel; }
+
+constexpr size_t kGroupWidth = 16;
+
+// The control bytes of an empty table, which never allocates: lookups see
+// no match and an empty slot, and iteration stops at once.
+alignas(16) inline constexpr ctrl_t kEmptyGroup[kGroupWidth] = {
+    kSentinel, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+    kEmpty,    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty};
+
+// The bits of the slots of a group which match, iterated from the lowest.
+class BitMask {
+ public:
+  class iterator {
+   public:
+    explicit iterator(uint32_t mask) : mask_(mask) { }
+    uint32_t operator*() const { return __builtin_ctz(mask_); }
+    iterator& operator++() {
+      mask_ &= mask_ - 1;
+      return *this;
+    }
+    bool operator!=(const iterator& other) const {
+      return mask_ != other.mask_;
+    }
+   private:
+    uint32_t mask_;
+  };
+
+  explicit BitMask(uint32_t mask) : mask_(mask) { }
+  explicit operator bool() const { return mask_ != 0; }
+  uint32_t LowestBitSet() const { return __builtin_ctz(mask_); }
+  uint32_t TrailingZeros() const {
+    return mask_ == 0 ? kGroupWidth : __builtin_ctz(mask_);
+  }
+  uint32_t LeadingZeros() const {
+    return mask_ == 0 ? kGroupWidth : __builtin_clz(mask_ << 16);
+  }
+  iterator begin() const { return iterator(mask_); }
+  iterator end() const { return iterator(0); }
+
+ private:
+  uint32_t mask_;
+};
+
+#ifdef __SSE2__
+class Group {
+ public:
+  explicit Group(const ctrl_t* pos)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) { }
+  BitMask Match(uint8_t h2) const {
+    return BitMask(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+  }
+  BitMask MatchEmpty() const {
+    return BitMask(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kEmpty), ctrl_)));
+  }
+  BitMask MatchEmptyOrDeleted() const {
+    return BitMask(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_)));
+  }
+ private:
+  __m128i ctrl_;
+};
+#else
+class Group {
+ public:
+  explicit Group(const ctrl_t* pos) { memcpy(ctrl_, pos, kGroupWidth); }
+  BitMask Match(uint8_t h2) const {
+    return Mask([h2](ctrl_t c) { return c == static_cast<ctrl_t>(h2); });
+  }
+  BitMask MatchEmpty() const {
+    return Mask([](ctrl_t c) { return c == kEmpty; });
+  }
+  BitMask MatchEmptyOrDeleted() const {
+    return Mask([](ctrl_t c) { return IsEmptyOrDeleted(c); });
+  }
+ private:
+  template <typename F>
+  BitMask Mask(F f) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      mask |= uint32_t{f(ctrl_[i])} << i;
+    }
+    return BitMask(mask);
+  }
+  ctrl_t ctrl_[kGroupWidth];
+};
+#endif
+
+// Visits the groups from the slot of H1, with steps of 16, 32, 48, ...
+// slots. As the capacity is a power of two minus one, the steps reach every
+// group before repeating.
+class ProbeSeq {
+ public:
+  ProbeSeq(size_t hash, size_t mask) : mask_(mask), offset_(hash & mask) { }
+  size_t offset() const { return offset_; }
+  size_t offset(size_t i) const { return (offset_ + i) & mask_; }
+  void next() {
+    index_ += kGroupWidth;
+    offset_ = (offset_ + index_) & mask_;
+  }
+ private:
+  size_t mask_;
+  size_t offset_;
+  size_t index_ = 0;
+};
+
+// Capacities are powers of two minus one, filled up to 7/8.
+inline size_t NormalizeCapacity(size_t n) {
+  return n == 0 ? 1 : ~size_t{0} >> __builtin_clzl(n);
+}
+inline size_t CapacityToGrowth(size_t capacity) {
+  return capacity - capacity / 8;
+}
+// Signed, so that a growth of 0 gives 0.
+inline size_t GrowthToLowerboundCapacity(size_t growth) {
+  return growth + static_cast<size_t>((static_cast<int64_t>(growth) - 1) / 7);
+}
+
+// Lookups take any key type when both the hash and the equality are
+// transparent, e.g. string_view for std::string keys.
+template <typename T, typename = void>
+struct IsTransparent : std::false_type { };
+template <typename T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>>
+    : std::true_type { };
+
+template <bool kTransparent>
+struct KeyArg {
+  template <typename K, typename KeyType>
+  using type = KeyType;
+};
+template <>
+struct KeyArg<true> {
+  template <typename K, typename KeyType>
+  using type = K;
+};
+
+// The default hash and equality of the keys of the containers.
+template <typename T>
+struct HashEq {
+  using Hash = absl::Hash<T>;
+  using Eq = std::equal_to<T>;
+};
+template <>
+struct HashEq<std::string> {
+  using Hash = StringHash;
+  using Eq = StringEq;
+};
+template <>
+struct HashEq<string_view> : HashEq<std::string> { };
+
+// Policy describes the slots: the slot_type, value_type and key_type, and
+// static functions to construct, destroy and transfer elements, and to get
+// the key and the value of a slot.
+template <typename Policy, typename Hash, typename Eq>
+class raw_hash_set {
+  using slot_type = typename Policy::slot_type;
+  static constexpr bool kTransparent =
+      IsTransparent<Hash>::value && IsTransparent<Eq>::value;
+  template <typename K>
+  using key_arg = typename KeyArg<kTransparent>::template type<
+      K, typename Policy::key_type>;
+
+ public:
+  using key_type = typename Policy::key_type;
+  using value_type = typename Policy::value_type;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = Eq;
+
+  class const_iterator;
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename raw_hash_set::value_type;
+    using reference = typename Policy::reference;
+    using pointer = typename std::remove_reference<reference>::type*;
+    using difference_type = ptrdiff_t;
+
+    iterator() { }
+    reference operator*() const { return Policy::element(slot_); }
+    pointer operator->() const { return &Policy::element(slot_); }
+    iterator& operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipEmptyOrDeleted();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const iterator& other) const {
+      return ctrl_ == other.ctrl_;
+    }
+    bool operator!=(const iterator& other) const {
+      return ctrl_ != other.ctrl_;
+    }
+
+   private:
+    friend class raw_hash_set;
+    iterator(const ctrl_t* ctrl, slot_type* slot) : ctrl_(ctrl), slot_(slot) { }
+    void SkipEmptyOrDeleted() {
+      while (IsEmptyOrDeleted(*ctrl_)) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+    const ctrl_t* ctrl_ = nullptr;
+    slot_type* slot_ = nullptr;
+  };
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename raw_hash_set::value_type;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using difference_type = ptrdiff_t;
+
+    const_iterator() { }
+    const_iterator(iterator it) : it_(it) { }
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &*it_; }
+    const_iterator& operator++() {
+      ++it_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++it_;
+      return tmp;
+    }
+    bool operator==(const const_iterator& other) const {
+      return it_ == other.it_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return it_ != other.it_;
+    }
+
+   private:
+    friend class raw_hash_set;
+    iterator it_;
+  };
+
+  raw_hash_set() { }
+  explicit raw_hash_set(size_t bucket_count, const Hash& hash = Hash(),
+                        const Eq& eq = Eq())
+      : hash_(hash), eq_(eq) {
+    if (bucket_count > 0) { Resize(NormalizeCapacity(bucket_count)); }
+  }
+  template <typename InputIter>
+  raw_hash_set(InputIter first, InputIter last) {
+    insert(first, last);
+  }
+  raw_hash_set(std::initializer_list<value_type> init)
+      : raw_hash_set(init.begin(), init.end()) { }
+  raw_hash_set(const raw_hash_set& other)
+      : hash_(other.hash_), eq_(other.eq_) {
+    reserve(other.size());
+    for (const auto& v : other) { insert(v); }
+  }
+  raw_hash_set(raw_hash_set&& other) noexcept
+      : ctrl_(other.ctrl_), slots_(other.slots_), size_(other.size_),
+        capacity_(other.capacity_), growth_left_(other.growth_left_),
+        hash_(std::move(other.hash_)), eq_(std::move(other.eq_)) {
+    other.ResetToEmpty();
+  }
+  raw_hash_set& operator=(const raw_hash_set& other) {
+    if (this != &other) {
+      raw_hash_set tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+  raw_hash_set& operator=(raw_hash_set&& other) noexcept {
+    raw_hash_set tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+  ~raw_hash_set() { DestroySlots(); }
+
+  iterator begin() {
+    iterator it(ctrl_, slots_);
+    it.SkipEmptyOrDeleted();
+    return it;
+  }
+  iterator end() { return iterator(ctrl_ + capacity_, nullptr); }
+  const_iterator begin() const {
+    return const_cast<raw_hash_set*>(this)->begin();
+  }
+  const_iterator end() const { return const_cast<raw_hash_set*>(this)->end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  void clear() {
+    if (capacity_ == 0) { return; }
+    DestroySlots();
+    ResetToEmpty();
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace(std::move(value));
+  }
+  template <typename InputIter>
+  void insert(InputIter first, InputIter last) {
+    for (; first != last; ++first) { emplace(*first); }
+  }
+  void insert(std::initializer_list<value_type> init) {
+    insert(init.begin(), init.end());
+  }
+
+  // Constructs the element first, to get its key, and drops it if the key
+  // is there already.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    alignas(slot_type) unsigned char raw[sizeof(slot_type)];
+    slot_type* tmp = reinterpret_cast<slot_type*>(raw);
+    Policy::construct(tmp, std::forward<Args>(args)...);
+    auto res = FindOrPrepareInsert(Policy::key(tmp));
+    if (res.second) {
+      Policy::transfer(slots_ + res.first, tmp);
+    } else {
+      Policy::destroy(tmp);
+    }
+    return {IteratorAt(res.first), res.second};
+  }
+
+  // Constructs the element from its key only when the key is not there.
+  // The key is converted to key_type on insertion only.
+  template <typename K = key_type, typename... Args>
+  std::pair<iterator, bool> LazyEmplace(const key_arg<K>& key,
+                                        Args&&... args) {
+    auto res = FindOrPrepareInsert(key);
+    if (res.second) {
+      Policy::construct(slots_ + res.first, std::forward<Args>(args)...);
+    }
+    return {IteratorAt(res.first), res.second};
+  }
+
+  template <typename K = key_type>
+  iterator find(const key_arg<K>& key) {
+    const size_t hash = hash_(key);
+    ProbeSeq seq(H1(hash), capacity_);
+    while (true) {
+      Group g(ctrl_ + seq.offset());
+      for (uint32_t i : g.Match(H2(hash))) {
+        const size_t index = seq.offset(i);
+        if (eq_(Policy::key(slots_ + index), key)) {
+          return IteratorAt(index);
+        }
+      }
+      if (g.MatchEmpty()) { return end(); }
+      seq.next();
+    }
+  }
+  template <typename K = key_type>
+  const_iterator find(const key_arg<K>& key) const {
+    return const_cast<raw_hash_set*>(this)->find(key);
+  }
+  template <typename K = key_type>
+  bool contains(const key_arg<K>& key) const { return find(key) != end(); }
+  template <typename K = key_type>
+  size_t count(const key_arg<K>& key) const { return contains(key) ? 1 : 0; }
+
+  // Unlike std containers, erasing by iterator returns nothing: finding the
+  // next element would cost a scan which most callers do not need.
+  // erase(it++) erases while iterating.
+  void erase(const_iterator it) { erase(it.it_); }
+  void erase(iterator it) {
+    Policy::destroy(it.slot_);
+    EraseMetaOnly(it.ctrl_ - ctrl_);
+  }
+  template <typename K = key_type>
+  size_t erase(const key_arg<K>& key) {
+    auto it = find(key);
+    if (it == end()) { return 0; }
+    erase(it);
+    return 1;
+  }
+
+  void reserve(size_t n) {
+    if (n > size_ + growth_left_) {
+      Resize(NormalizeCapacity(GrowthToLowerboundCapacity(n)));
+    }
+  }
+  void rehash(size_t n) {
+    if (n == 0 && capacity_ == 0) { return; }
+    if (n == 0 && size_ == 0) {
+      clear();
+      return;
+    }
+    size_t capacity = NormalizeCapacity(
+        std::max(n, GrowthToLowerboundCapacity(size_)));
+    if (n == 0 || capacity > capacity_) { Resize(capacity); }
+  }
+
+  void swap(raw_hash_set& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(eq_, other.eq_);
+  }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+
+ protected:
+  // Returns the slot of key and false if it is there, or else a free slot,
+  // marked full, and true. The caller constructs the element in the slot.
+  template <typename K>
+  std::pair<size_t, bool> FindOrPrepareInsert(const K& key) {
+    const size_t hash = hash_(key);
+    ProbeSeq seq(H1(hash), capacity_);
+    while (true) {
+      Group g(ctrl_ + seq.offset());
+      for (uint32_t i : g.Match(H2(hash))) {
+        const size_t index = seq.offset(i);
+        if (eq_(Policy::key(slots_ + index), key)) { return {index, false}; }
+      }
+      if (g.MatchEmpty()) { break; }
+      seq.next();
+    }
+    return {PrepareInsert(hash), true};
+  }
+
+  iterator IteratorAt(size_t index) {
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+ private:
+  // H1 is salted with the address of the control bytes, so that inserting
+  // the elements of one table into another in iteration order does not
+  // pile them up in the same places.
+  size_t H1(size_t hash) const {
+    return (hash >> 7) ^ (reinterpret_cast<uintptr_t>(ctrl_) >> 12);
+  }
+  static uint8_t H2(size_t hash) { return hash & 0x7f; }
+
+  size_t FindFirstNonFull(size_t hash) const {
+    ProbeSeq seq(H1(hash), capacity_);
+    while (true) {
+      auto mask = Group(ctrl_ + seq.offset()).MatchEmptyOrDeleted();
+      if (mask) { return seq.offset(mask.LowestBitSet()); }
+      seq.next();
+    }
+  }
+
+  size_t PrepareInsert(size_t hash) {
+    size_t index = FindFirstNonFull(hash);
+    if (growth_left_ == 0 && ctrl_[index] != kDeleted) {
+      RehashAndGrowIfNecessary();
+      index = FindFirstNonFull(hash);
+    }
+    ++size_;
+    growth_left_ -= ctrl_[index] == kEmpty;
+    SetCtrl(index, H2(hash));
+    return index;
+  }
+
+  // Sets the control byte of a slot and its copy at the end.
+  void SetCtrl(size_t index, ctrl_t c) {
+    ctrl_[index] = c;
+    ctrl_[((index - (kGroupWidth - 1)) & capacity_) +
+          ((kGroupWidth - 1) & capacity_)] = c;
+  }
+
+  // A slot can go back to empty if no probe ever went past it, which is
+  // the case if there was an empty slot in every window of 16 slots
+  // around it. Otherwise it is left deleted, to keep the probes going.
+  void EraseMetaOnly(size_t index) {
+    --size_;
+    const size_t index_before = (index - kGroupWidth) & capacity_;
+    const auto empty_after = Group(ctrl_ + index).MatchEmpty();
+    const auto empty_before = Group(ctrl_ + index_before).MatchEmpty();
+    const bool was_never_full =
+        empty_before && empty_after &&
+        empty_after.TrailingZeros() + empty_before.LeadingZeros() <
+            kGroupWidth;
+    SetCtrl(index, was_never_full ? kEmpty : kDeleted);
+    growth_left_ += was_never_full;
+  }
+
+  // A table full of deleted slots is rehashed at the same capacity to
+  // drop them; otherwise it doubles.
+  void RehashAndGrowIfNecessary() {
+    if (capacity_ > kGroupWidth && size_ * 32 <= capacity_ * 25) {
+      Resize(capacity_);
+    } else {
+      Resize(capacity_ * 2 + 1);
+    }
+  }
+
+  static size_t SlotOffset(size_t capacity) {
+    const size_t align = alignof(slot_type);
+    return (capacity + kGroupWidth + align - 1) & ~(align - 1);
+  }
+  static size_t AllocSize(size_t capacity) {
+    return SlotOffset(capacity) + capacity * sizeof(slot_type);
+  }
+  static constexpr std::align_val_t kAlign =
+      std::align_val_t(alignof(slot_type) > 16 ? alignof(slot_type) : 16);
+
+  void Resize(size_t new_capacity) {
+    ctrl_t* old_ctrl = ctrl_;
+    slot_type* old_slots = slots_;
+    const size_t old_capacity = capacity_;
+
+    char* mem = static_cast<char*>(
+        ::operator new(AllocSize(new_capacity), kAlign));
+    ctrl_ = reinterpret_cast<ctrl_t*>(mem);
+    slots_ = reinterpret_cast<slot_type*>(mem + SlotOffset(new_capacity));
+    capacity_ = new_capacity;
+    memset(ctrl_, kEmpty, new_capacity + kGroupWidth);
+    ctrl_[new_capacity] = kSentinel;
+    growth_left_ = CapacityToGrowth(new_capacity) - size_;
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (IsFull(old_ctrl[i])) {
+        const size_t hash = hash_(Policy::key(old_slots + i));
+        const size_t index = FindFirstNonFull(hash);
+        SetCtrl(index, H2(hash));
+        Policy::transfer(slots_ + index, old_slots + i);
+      }
+    }
+    if (old_capacity > 0) {
+      ::operator delete(old_ctrl, AllocSize(old_capacity), kAlign);
+    }
+  }
+
+  void DestroySlots() {
+    if (capacity_ == 0) { return; }
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (IsFull(ctrl_[i])) { Policy::destroy(slots_ + i); }
+    }
+    ::operator delete(ctrl_, AllocSize(capacity_), kAlign);
+  }
+
+  void ResetToEmpty() {
+    ctrl_ = const_cast<ctrl_t*>(kEmptyGroup);
+    slots_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+    growth_left_ = 0;
+  }
+
+  ctrl_t* ctrl_ = const_cast<ctrl_t*>(kEmptyGroup);
+  slot_type* slots_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  size_t growth_left_ = 0;
+  Hash hash_;
+  Eq eq_;
+};
+
+}  // namespace container_internal
+}  // namespace absl
+
+#endif  // ABSL_RAW_HASH_SET_H_
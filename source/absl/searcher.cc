@@ -0,0 +1,186 @@
+#include "absl/searcher.h"
+
+namespace absl {
+namespace search_internal {
+
+namespace {
+constexpr size_t npos = string_view::npos;
+
+// Reads a text forward, or backward from its end, so that the backward
+// search is the forward search over the reversed needle and haystack.
+class ForwardText {
+ public:
+  explicit ForwardText(const char* p) : p_(p) { }
+  unsigned char operator[](size_t i) const {
+    return static_cast<unsigned char>(p_[i]);
+  }
+ private:
+  const char* p_;
+};
+
+class BackwardText {
+ public:
+  explicit BackwardText(const char* end) : end_(end) { }
+  unsigned char operator[](size_t i) const {
+    return static_cast<unsigned char>(end_[-1 - static_cast<ptrdiff_t>(i)]);
+  }
+ private:
+  const char* end_;
+};
+
+// Returns the start of the maximal suffix of x under the byte order, or the
+// reversed order, and its period in *period.
+template <typename Text>
+size_t MaximalSuffix(const Text& x, size_t m, bool reversed, size_t* period) {
+  // max_suffix is one before the suffix start and wraps around from -1.
+  size_t max_suffix = npos;
+  size_t j = 0;
+  size_t k = 1;
+  size_t p = 1;
+  while (j + k < m) {
+    unsigned char a = x[j + k];
+    unsigned char b = x[max_suffix + k];
+    if (reversed ? a > b : a < b) {
+      j += k;
+      k = 1;
+      p = j - max_suffix;
+    } else if (a == b) {
+      if (k != p) {
+        ++k;
+      } else {
+        j += p;
+        k = 1;
+      }
+    } else {
+      max_suffix = j++;
+      k = p = 1;
+    }
+  }
+  *period = p;
+  return max_suffix + 1;
+}
+
+template <typename Text>
+void Plan(const Text& x, size_t m, TwoWayPlan* plan) {
+  if (m < 3) {
+    plan->suffix = m - 1;
+    plan->period = 1;
+  } else {
+    // The later of the two maximal suffixes starts a critical factorization.
+    size_t period;
+    size_t reversed_period;
+    size_t suffix = MaximalSuffix(x, m, false, &period);
+    size_t reversed_suffix = MaximalSuffix(x, m, true, &reversed_period);
+    if (reversed_suffix < suffix) {
+      plan->suffix = suffix;
+      plan->period = period;
+    } else {
+      plan->suffix = reversed_suffix;
+      plan->period = reversed_period;
+    }
+  }
+  // The needle is periodic if its left part recurs one period later.
+  plan->periodic = plan->period + plan->suffix <= m;
+  for (size_t i = 0; plan->periodic && i < plan->suffix; ++i) {
+    plan->periodic = x[i] == x[i + plan->period];
+  }
+  if (!plan->periodic) {
+    plan->period = std::max(plan->suffix, m - plan->suffix) + 1;
+  }
+  for (auto& shift : plan->shift) { shift = m; }
+  for (size_t i = 0; i < m; ++i) { plan->shift[x[i]] = m - 1 - i; }
+}
+
+// Returns the first window of y which holds x, or npos.
+template <typename Text>
+size_t Search(const Text& x, size_t m, const Text& y, size_t n,
+              const TwoWayPlan& plan) {
+  if (n < m) { return npos; }
+  const size_t suffix = plan.suffix;
+  const size_t period = plan.period;
+  // For a periodic needle, memory is the length of the prefix which is
+  // known to match after a shift by one period.
+  size_t memory = 0;
+  size_t j = 0;
+  while (j <= n - m) {
+    size_t shift = plan.shift[y[j + m - 1]];
+    if (shift > 0) {
+      if (plan.periodic && memory > 0 && shift < period) {
+        shift = m - period;
+      }
+      memory = 0;
+      j += shift;
+      continue;
+    }
+    // The last byte matches. Match the right part, then the left one.
+    size_t i = std::max(suffix, memory);
+    while (i < m - 1 && x[i] == y[i + j]) { ++i; }
+    if (i < m - 1) {
+      j += i - suffix + 1;
+      memory = 0;
+      continue;
+    }
+    // i wraps around to npos below the start of the needle.
+    i = suffix - 1;
+    while (i + 1 > memory && x[i] == y[i + j]) { --i; }
+    if (i + 1 <= memory) { return j; }
+    j += period;
+    memory = plan.periodic ? m - period : 0;
+  }
+  return npos;
+}
+}  // namespace
+
+size_t TwoWayFind(string_view haystack, string_view needle) {
+  TwoWayPlan plan;
+  ForwardText x(needle.data());
+  Plan(x, needle.size(), &plan);
+  return Search(x, needle.size(), ForwardText(haystack.data()),
+                haystack.size(), plan);
+}
+
+size_t TwoWayRFind(string_view haystack, string_view needle) {
+  TwoWayPlan plan;
+  BackwardText x(needle.end());
+  Plan(x, needle.size(), &plan);
+  size_t pos = Search(x, needle.size(), BackwardText(haystack.end()),
+                      haystack.size(), plan);
+  return pos == npos ? npos : haystack.size() - pos - needle.size();
+}
+
+}  // namespace search_internal
+
+Searcher::Searcher(string_view needle)
+    : needle_(needle.data(), needle.size()) {
+  if (!needle_.empty()) {
+    search_internal::Plan(search_internal::ForwardText(needle_.data()),
+                          needle_.size(), &forward_);
+    search_internal::Plan(
+        search_internal::BackwardText(needle_.data() + needle_.size()),
+        needle_.size(), &backward_);
+  }
+}
+
+size_t Searcher::Find(string_view haystack, size_t pos) const {
+  if (pos > haystack.size()) { return string_view::npos; }
+  if (needle_.empty()) { return pos; }
+  size_t found = search_internal::Search(
+      search_internal::ForwardText(needle_.data()), needle_.size(),
+      search_internal::ForwardText(haystack.data() + pos),
+      haystack.size() - pos, forward_);
+  return found == string_view::npos ? found : pos + found;
+}
+
+size_t Searcher::RFind(string_view haystack, size_t pos) const {
+  if (haystack.size() < needle_.size()) { return string_view::npos; }
+  size_t last = std::min(pos, haystack.size() - needle_.size());
+  if (needle_.empty()) { return last; }
+  size_t window = last + needle_.size();
+  size_t found = search_internal::Search(
+      search_internal::BackwardText(needle_.data() + needle_.size()),
+      needle_.size(), search_internal::BackwardText(haystack.data() + window),
+      window, backward_);
+  return found == string_view::npos ? found : window - found - needle_.size();
+}
+
+}  // namespace absl
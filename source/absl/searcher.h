@@ -0,0 +1,54 @@
+#ifndef ABSL_SEARCHER_H_
+#define ABSL_SEARCHER_H_
+
+#include "absl/string_view.h"
+
+namespace absl {
+namespace search_internal {
+
+// The preprocessed needle of the Two-Way algorithm of Crochemore and Perrin:
+// its critical factorization, and a table of bad character shifts which
+// skips most windows after looking at their last byte only.
+struct TwoWayPlan {
+  size_t suffix = 0;
+  size_t period = 0;
+  bool periodic = false;
+  size_t shift[256];
+};
+
+// One-off searches, which plan the needle for the single call. They take
+// linear time in the worst case. The needle must not be empty.
+size_t TwoWayFind(string_view haystack, string_view needle);
+size_t TwoWayRFind(string_view haystack, string_view needle);
+
+}  // namespace search_internal
+
+// A needle preprocessed once for many searches, both forward and backward.
+// Each search takes time linear in the size of the haystack, whatever the
+// haystack and the needle contain.
+//
+//   absl::Searcher searcher("needle");
+//   for (const auto& line : lines) {
+//     if (searcher.Find(line) != absl::string_view::npos) { ... }
+//   }
+class Searcher {
+ public:
+  explicit Searcher(string_view needle);
+  const std::string& needle() const { return needle_; }
+
+  // The first occurrence which starts at or after pos, like
+  // std::string::find. Returns npos if there is none.
+  size_t Find(string_view haystack, size_t pos = 0) const;
+  // The last occurrence which starts at or before pos, like
+  // std::string::rfind. Returns npos if there is none.
+  size_t RFind(string_view haystack, size_t pos = string_view::npos) const;
+
+ private:
+  std::string needle_;
+  search_internal::TwoWayPlan forward_;
+  search_internal::TwoWayPlan backward_;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_SEARCHER_H_
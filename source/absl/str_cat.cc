@@ -0,0 +1,161 @@
+#include "absl/str_cat.h"
+
+#include <charconv>
+
+namespace absl {
+
+namespace {
+// The two digits of each number below 100.
+constexpr char kTwoDigits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+size_t CountDigits(uint64_t i) {
+  size_t n = 1;
+  while (true) {
+    if (i < 10) { return n; }
+    if (i < 100) { return n + 1; }
+    if (i < 1000) { return n + 2; }
+    if (i < 10000) { return n + 3; }
+    i /= 10000;
+    n += 4;
+  }
+}
+
+// Grows s by n chars, and returns where they start.
+char* Grow(std::string* s, size_t n) {
+  size_t old_size = s->size();
+  s->resize(old_size + n);
+  return &(*s)[old_size];
+}
+
+char* Append(char* out, string_view x) {
+  const size_t n = x.size();
+  if (n != 0) { memcpy(out, x.data(), n); }
+  return out + n;
+}
+}  // namespace
+
+char* FastIntToBuffer(uint64_t i, char* buf) {
+  // The digits are written from the end, two at a time.
+  char* end = buf + CountDigits(i);
+  char* p = end;
+  while (i >= 100) {
+    const size_t two = (i % 100) * 2;
+    i /= 100;
+    *--p = kTwoDigits[two + 1];
+    *--p = kTwoDigits[two];
+  }
+  if (i >= 10) {
+    *--p = kTwoDigits[i * 2 + 1];
+    *--p = kTwoDigits[i * 2];
+  } else {
+    *--p = static_cast<char>('0' + i);
+  }
+  return end;
+}
+
+char* FastIntToBuffer(int64_t i, char* buf) {
+  uint64_t magnitude = static_cast<uint64_t>(i);
+  if (i < 0) {
+    *buf++ = '-';
+    magnitude = 0 - magnitude;
+  }
+  return FastIntToBuffer(magnitude, buf);
+}
+
+// Like "%g", but without the locale.
+AlphaNum::AlphaNum(double d) {
+  auto result = std::to_chars(digits_, digits_ + sizeof(digits_), d,
+                              std::chars_format::general, 6);
+  piece_ = string_view(digits_, result.ptr - digits_);
+}
+
+std::string StrCat() { return std::string(); }
+
+std::string StrCat(const AlphaNum& a) {
+  return std::string(a.data(), a.size());
+}
+
+std::string StrCat(const AlphaNum& a, const AlphaNum& b) {
+  std::string result;
+  char* out = Grow(&result, a.size() + b.size());
+  out = Append(out, a.Piece());
+  Append(out, b.Piece());
+  return result;
+}
+
+std::string StrCat(const AlphaNum& a, const AlphaNum& b, const AlphaNum& c) {
+  std::string result;
+  char* out = Grow(&result, a.size() + b.size() + c.size());
+  out = Append(out, a.Piece());
+  out = Append(out, b.Piece());
+  Append(out, c.Piece());
+  return result;
+}
+
+std::string StrCat(const AlphaNum& a, const AlphaNum& b, const AlphaNum& c,
+                   const AlphaNum& d) {
+  std::string result;
+  char* out = Grow(&result, a.size() + b.size() + c.size() + d.size());
+  out = Append(out, a.Piece());
+  out = Append(out, b.Piece());
+  out = Append(out, c.Piece());
+  Append(out, d.Piece());
+  return result;
+}
+
+void StrAppend(std::string* dest, const AlphaNum& a) {
+  dest->append(a.data(), a.size());
+}
+
+void StrAppend(std::string* dest, const AlphaNum& a, const AlphaNum& b) {
+  char* out = Grow(dest, a.size() + b.size());
+  out = Append(out, a.Piece());
+  Append(out, b.Piece());
+}
+
+void StrAppend(std::string* dest, const AlphaNum& a, const AlphaNum& b,
+               const AlphaNum& c) {
+  char* out = Grow(dest, a.size() + b.size() + c.size());
+  out = Append(out, a.Piece());
+  out = Append(out, b.Piece());
+  Append(out, c.Piece());
+}
+
+void StrAppend(std::string* dest, const AlphaNum& a, const AlphaNum& b,
+               const AlphaNum& c, const AlphaNum& d) {
+  char* out = Grow(dest, a.size() + b.size() + c.size() + d.size());
+  out = Append(out, a.Piece());
+  out = Append(out, b.Piece());
+  out = Append(out, c.Piece());
+  Append(out, d.Piece());
+}
+
+namespace strings_internal {
+
+std::string CatPieces(std::initializer_list<string_view> pieces) {
+  std::string result;
+  AppendPieces(&result, pieces);
+  return result;
+}
+
+void AppendPieces(std::string* dest,
+                  std::initializer_list<string_view> pieces) {
+  size_t total = 0;
+  for (string_view piece : pieces) { total += piece.size(); }
+  char* out = Grow(dest, total);
+  for (string_view piece : pieces) { out = Append(out, piece); }
+}
+
+}  // namespace strings_internal
+
+}  // namespace absl
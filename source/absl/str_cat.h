@@ -0,0 +1,98 @@
+#ifndef ABSL_STR_CAT_H_
+#define ABSL_STR_CAT_H_
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "absl/string_view.h"
+
+namespace absl {
+
+namespace strings_internal {
+// Large enough for any 64-bit integer and any double in "%g" form.
+constexpr size_t kFastToBufferSize = 32;
+}  // namespace strings_internal
+
+// Writes the decimal form of i at buf, without a terminating NUL, and
+// returns the end of it. buf must have room for 20 chars, 21 with a sign.
+char* FastIntToBuffer(uint64_t i, char* buf);
+char* FastIntToBuffer(int64_t i, char* buf);
+
+// An argument of StrCat and StrAppend: a string, or a number formatted
+// into a buffer of its own on the stack. Floating point numbers get 6
+// significant digits, as from operator<<.
+class AlphaNum {
+ public:
+  AlphaNum(int i) : AlphaNum(static_cast<long long>(i)) { }
+  AlphaNum(unsigned int i) : AlphaNum(static_cast<unsigned long long>(i)) { }
+  AlphaNum(long i) : AlphaNum(static_cast<long long>(i)) { }
+  AlphaNum(unsigned long i) : AlphaNum(static_cast<unsigned long long>(i)) { }
+  AlphaNum(long long i)
+      : piece_(digits_, FastIntToBuffer(static_cast<int64_t>(i), digits_) -
+                            digits_) { }
+  AlphaNum(unsigned long long i)
+      : piece_(digits_, FastIntToBuffer(static_cast<uint64_t>(i), digits_) -
+                            digits_) { }
+  AlphaNum(float f) : AlphaNum(static_cast<double>(f)) { }
+  AlphaNum(double d);
+
+  AlphaNum(const char* s) : piece_(s) { }
+  AlphaNum(string_view s) : piece_(s) { }
+  AlphaNum(const std::string& s) : piece_(s) { }
+
+  // A char would be taken for an integer; pass string_view(&c, 1).
+  AlphaNum(char c) = delete;
+  AlphaNum(const AlphaNum&) = delete;
+  AlphaNum& operator=(const AlphaNum&) = delete;
+
+  string_view Piece() const { return piece_; }
+  size_t size() const { return piece_.size(); }
+  const char* data() const { return piece_.data(); }
+
+ private:
+  string_view piece_;
+  char digits_[strings_internal::kFastToBufferSize];
+};
+
+namespace strings_internal {
+std::string CatPieces(std::initializer_list<string_view> pieces);
+void AppendPieces(std::string* dest, std::initializer_list<string_view> pieces);
+}  // namespace strings_internal
+
+// Concatenates the arguments into a string which is allocated once, at its
+// exact size:
+//   std::string key = absl::StrCat(file, ":", line);
+std::string StrCat();
+std::string StrCat(const AlphaNum& a);
+std::string StrCat(const AlphaNum& a, const AlphaNum& b);
+std::string StrCat(const AlphaNum& a, const AlphaNum& b, const AlphaNum& c);
+std::string StrCat(const AlphaNum& a, const AlphaNum& b, const AlphaNum& c,
+                   const AlphaNum& d);
+template <typename... AV>
+std::string StrCat(const AlphaNum& a, const AlphaNum& b, const AlphaNum& c,
+                   const AlphaNum& d, const AlphaNum& e, const AV&... args) {
+  return strings_internal::CatPieces(
+      {a.Piece(), b.Piece(), c.Piece(), d.Piece(), e.Piece(),
+       static_cast<const AlphaNum&>(args).Piece()...});
+}
+
+// Appends the arguments to dest, growing it at most once. The arguments
+// must not point into dest.
+void StrAppend(std::string* dest, const AlphaNum& a);
+void StrAppend(std::string* dest, const AlphaNum& a, const AlphaNum& b);
+void StrAppend(std::string* dest, const AlphaNum& a, const AlphaNum& b,
+               const AlphaNum& c);
+void StrAppend(std::string* dest, const AlphaNum& a, const AlphaNum& b,
+               const AlphaNum& c, const AlphaNum& d);
+template <typename... AV>
+void StrAppend(std::string* dest, const AlphaNum& a, const AlphaNum& b,
+               const AlphaNum& c, const AlphaNum& d, const AlphaNum& e,
+               const AV&... args) {
+  strings_internal::AppendPieces(
+      dest, {a.Piece(), b.Piece(), c.Piece(), d.Piece(), e.Piece(),
+             static_cast<const AlphaNum&>(args).Piece()...});
+}
+
+}  // namespace absl
+
+#endif  // ABSL_STR_CAT_H_
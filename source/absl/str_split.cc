@@ -0,0 +1,40 @@
+#include "absl/str_split.h"
+
+namespace absl {
+
+// An empty delimiter is found after each char, so the pieces are the
+// chars.
+static string_view AfterChar(string_view text, size_t pos) {
+  return pos + 1 < text.size() ? string_view(text.data() + pos + 1, 0)
+                               : string_view(text.end(), 0);
+}
+
+string_view ByString::Find(string_view text, size_t pos) const {
+  if (delimiter_.size() == 1) {
+    size_t found = text.find(delimiter_[0], pos);
+    return found == string_view::npos ? string_view(text.end(), 0)
+                                      : text.substr(found, 1);
+  }
+  if (delimiter_.empty()) { return AfterChar(text, pos); }
+  size_t found = text.find(delimiter_, pos);
+  return found == string_view::npos
+      ? string_view(text.end(), 0)
+      : text.substr(found, delimiter_.size());
+}
+
+string_view ByAnyChar::Find(string_view text, size_t pos) const {
+  if (empty_) { return AfterChar(text, pos); }
+  if (pos >= text.size()) { return string_view(text.end(), 0); }
+  size_t found = search_internal::GetSearchKernels().find_first_of(
+      text.data() + pos, text.size() - pos, set_, false);
+  return found == string_view::npos ? string_view(text.end(), 0)
+                                    : text.substr(pos + found, 1);
+}
+
+string_view ByLength::Find(string_view text, size_t pos) const {
+  return length_ > 0 && pos + length_ < text.size()
+      ? string_view(text.data() + pos + length_, 0)
+      : string_view(text.end(), 0);
+}
+
+}  // namespace absl
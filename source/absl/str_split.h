@@ -0,0 +1,216 @@
+#ifndef ABSL_STR_SPLIT_H_
+#define ABSL_STR_SPLIT_H_
+
+#include <iterator>
+#include <vector>
+
+#include "absl/char_search.h"
+#include "absl/string_view.h"
+
+namespace absl {
+
+// Splits text into pieces around a delimiter, lazily: the pieces are views
+// into the text, found one at a time as the range is iterated, so nothing
+// is allocated. The text must outlive the range.
+//
+//   for (absl::string_view field : absl::StrSplit(line, ',')) { ... }
+//   std::vector<std::string> words =
+//       absl::StrSplit(text, absl::ByAnyChar(" \t"), absl::SkipEmpty());
+//
+// A delimiter is a class with a member
+//   string_view Find(string_view text, size_t pos) const;
+// which returns the first delimiter at or after pos, or an empty view at
+// text.end() if there is none. A char delimits with ByChar, a string with
+// ByString.
+//
+// Text without delimiters, the empty text included, is a single piece.
+// Empty delimiters split the text into chars.
+
+class ByChar {
+ public:
+  explicit ByChar(char c) : c_(c) { }
+  string_view Find(string_view text, size_t pos) const {
+    size_t found = text.find(c_, pos);
+    return found == string_view::npos ? string_view(text.end(), 0)
+                                      : text.substr(found, 1);
+  }
+ private:
+  char c_;
+};
+
+class ByString {
+ public:
+  // The delimiter is copied, so it may be a temporary.
+  explicit ByString(string_view delimiter)
+      : delimiter_(delimiter.data(), delimiter.size()) { }
+  string_view Find(string_view text, size_t pos) const;
+ private:
+  std::string delimiter_;
+};
+
+// Any one of the chars delimits.
+class ByAnyChar {
+ public:
+  explicit ByAnyChar(string_view chars)
+      : set_(chars), empty_(chars.empty()) { }
+  string_view Find(string_view text, size_t pos) const;
+ private:
+  search_internal::CharSet set_;
+  bool empty_;
+};
+
+// Pieces of a fixed length; the last one may be shorter.
+class ByLength {
+ public:
+  explicit ByLength(size_t length) : length_(length) { }
+  string_view Find(string_view text, size_t pos) const;
+ private:
+  size_t length_;
+};
+
+// Predicates which filter the pieces.
+struct AllowEmpty {
+  bool operator()(string_view) const { return true; }
+};
+struct SkipEmpty {
+  bool operator()(string_view s) const { return !s.empty(); }
+};
+// Skips the pieces which are empty or all whitespace.
+struct SkipWhitespace {
+  bool operator()(string_view s) const {
+    return s.find_first_not_of(" \t\n\v\f\r") != string_view::npos;
+  }
+};
+
+namespace strings_internal {
+
+// Chars delimit as ByChar, and strings as ByString.
+template <typename Delimiter>
+struct SelectDelimiter {
+  using type = Delimiter;
+};
+template <>
+struct SelectDelimiter<char> {
+  using type = ByChar;
+};
+template <>
+struct SelectDelimiter<const char*> {
+  using type = ByString;
+};
+template <>
+struct SelectDelimiter<char*> {
+  using type = ByString;
+};
+template <>
+struct SelectDelimiter<string_view> {
+  using type = ByString;
+};
+template <>
+struct SelectDelimiter<std::string> {
+  using type = ByString;
+};
+
+template <typename Delimiter, typename Predicate>
+class Splitter {
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = string_view;
+    using difference_type = ptrdiff_t;
+    using pointer = const string_view*;
+    using reference = const string_view&;
+
+    const_iterator() : splitter_(nullptr), state_(kEnd) { }
+    explicit const_iterator(const Splitter* splitter)
+        : splitter_(splitter), state_(kInit) {
+      ++*this;
+    }
+
+    reference operator*() const { return piece_; }
+    pointer operator->() const { return &piece_; }
+    const_iterator& operator++() {
+      const string_view text = splitter_->text_;
+      do {
+        if (state_ == kLastPiece) {
+          state_ = kEnd;
+          return *this;
+        }
+        string_view delimiter = splitter_->delimiter_.Find(text, pos_);
+        if (delimiter.data() == text.end()) { state_ = kLastPiece; }
+        piece_ = string_view(text.data() + pos_,
+                             delimiter.data() - (text.data() + pos_));
+        pos_ += piece_.size() + delimiter.size();
+      } while (!splitter_->predicate_(piece_));
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    // Only the end is ever compared, in practice.
+    bool operator==(const const_iterator& other) const {
+      return state_ == other.state_ &&
+             (state_ == kEnd || piece_.data() == other.piece_.data());
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    enum State { kInit, kLastPiece, kEnd };
+    const Splitter* splitter_;
+    State state_;
+    size_t pos_ = 0;
+    string_view piece_;
+  };
+
+  Splitter(string_view text, Delimiter delimiter, Predicate predicate)
+      : text_(text), delimiter_(std::move(delimiter)),
+        predicate_(std::move(predicate)) { }
+
+  const_iterator begin() const { return const_iterator(this); }
+  const_iterator end() const { return const_iterator(); }
+
+  // The pieces are only copied when the range is converted to a vector.
+  operator std::vector<string_view>() const {
+    return std::vector<string_view>(begin(), end());
+  }
+  operator std::vector<std::string>() const {
+    std::vector<std::string> pieces;
+    for (string_view piece : *this) {
+      pieces.emplace_back(piece.data(), piece.size());
+    }
+    return pieces;
+  }
+
+ private:
+  string_view text_;
+  Delimiter delimiter_;
+  Predicate predicate_;
+};
+
+}  // namespace strings_internal
+
+template <typename Delimiter, typename Predicate = AllowEmpty>
+strings_internal::Splitter<
+    typename strings_internal::SelectDelimiter<Delimiter>::type, Predicate>
+StrSplit(string_view text, Delimiter delimiter,
+         Predicate predicate = Predicate()) {
+  using D = typename strings_internal::SelectDelimiter<Delimiter>::type;
+  return strings_internal::Splitter<D, Predicate>(
+      text, D(std::move(delimiter)), std::move(predicate));
+}
+
+// The pieces would point into the temporary string.
+template <typename String, typename Delimiter,
+          typename Predicate = AllowEmpty,
+          typename = typename std::enable_if<
+              std::is_same<String, std::string>::value>::type>
+void StrSplit(String&& text, Delimiter delimiter,
+              Predicate predicate = Predicate()) = delete;
+
+}  // namespace absl
+
+#endif  // ABSL_STR_SPLIT_H_
@@ -0,0 +1,256 @@
+#include "absl/string_dict.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace absl {
+
+namespace {
+constexpr char kMagic[8] = {'X', 'S', 'D', 'I', 'C', 'T', '1', '\n'};
+constexpr size_t kHeaderSize = sizeof(kMagic) + 6 * sizeof(uint32_t);
+constexpr uint64_t kMaxSize = 0xffffffffULL;
+
+inline uint32_t Load32(const char* p) {
+  auto* b = reinterpret_cast<const unsigned char*>(p);
+  return static_cast<uint32_t>(b[0]) | static_cast<uint32_t>(b[1]) << 8 |
+         static_cast<uint32_t>(b[2]) << 16 | static_cast<uint32_t>(b[3]) << 24;
+}
+
+inline void Append32(uint32_t value, std::string* out) {
+  char b[4] = {static_cast<char>(value), static_cast<char>(value >> 8),
+               static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+  out->append(b, sizeof(b));
+}
+
+inline void Store32(uint32_t value, char* p) {
+  for (int i = 0; i < 4; ++i) { p[i] = static_cast<char>(value >> (8 * i)); }
+}
+
+void AppendVarint(uint32_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Reads a varint from the front of *s. Returns false if s ends first or
+// the varint does not fit 32 bits.
+bool ReadVarint(string_view* s, uint32_t* value) {
+  uint32_t result = 0;
+  for (int shift = 0; shift < 35 && !s->empty(); shift += 7) {
+    auto b = static_cast<unsigned char>(s->front());
+    s->remove_prefix(1);
+    result |= static_cast<uint32_t>(b & 0x7f) << shift;
+    if (b < 0x80) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Decodes the next key of a block into *key, which holds the key before.
+bool ReadKey(string_view* block, std::string* key) {
+  uint32_t shared;
+  uint32_t length;
+  if (!ReadVarint(block, &shared) || !ReadVarint(block, &length) ||
+      shared > key->size() || length > block->size()) {
+    return false;
+  }
+  key->resize(shared);
+  key->append(block->data(), length);
+  block->remove_prefix(length);
+  return true;
+}
+}  // namespace
+
+bool StringDict::Init(string_view data) {
+  *this = StringDict();
+  if (data.size() < kHeaderSize ||
+      memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+  const char* p = data.data() + sizeof(kMagic);
+  uint64_t count = Load32(p);
+  uint64_t block_size = Load32(p + 4);
+  uint64_t block_count = Load32(p + 8);
+  uint64_t index_offset = Load32(p + 12);
+  uint64_t values_offset = Load32(p + 16);
+  uint64_t size = Load32(p + 20);
+  if (size != data.size() || block_size == 0 ||
+      block_count != (count + block_size - 1) / block_size ||
+      index_offset + 4 * (block_count + 1) > values_offset ||
+      values_offset + 4 * (count + 1) > size) {
+    return false;
+  }
+  // Only the header is read here, so that a large mapped dictionary is not
+  // paged in up front. The offsets are checked as they are used.
+  data_ = data;
+  count_ = count;
+  block_size_ = block_size;
+  block_count_ = block_count;
+  blocks_end_ = index_offset;
+  index_ = data.data() + index_offset;
+  value_offsets_ = data.data() + values_offset;
+  values_ = value_offsets_ + 4 * (count + 1);
+  values_size_ = size - values_offset - 4 * (count + 1);
+  return true;
+}
+
+string_view StringDict::Block(size_t block) const {
+  uint32_t begin = Load32(index_ + 4 * block);
+  uint32_t end = Load32(index_ + 4 * (block + 1));
+  if (begin < kHeaderSize || begin > end || end > blocks_end_) {
+    return string_view();
+  }
+  return data_.substr(begin, end - begin);
+}
+
+string_view StringDict::BlockHead(size_t block) const {
+  string_view s = Block(block);
+  uint32_t shared;
+  uint32_t length;
+  if (!ReadVarint(&s, &shared) || !ReadVarint(&s, &length) || shared != 0 ||
+      length > s.size()) {
+    return string_view();
+  }
+  return s.substr(0, length);
+}
+
+size_t StringDict::ScanBlock(size_t block, string_view key,
+                             bool* found) const {
+  *found = false;
+  string_view s = Block(block);
+  const size_t first = block * block_size_;
+  const size_t last = std::min(count_, first + block_size_);
+  std::string current;
+  for (size_t i = first; i < last; ++i) {
+    if (!ReadKey(&s, &current)) { return last; }
+    int c = string_view(current).compare(key);
+    if (c >= 0) {
+      *found = c == 0;
+      return i;
+    }
+  }
+  return last;
+}
+
+size_t StringDict::BlocksUpTo(string_view key) const {
+  size_t lo = 0;
+  size_t hi = block_count_;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (BlockHead(mid).compare(key) <= 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+size_t StringDict::LowerBound(string_view key) const {
+  size_t blocks = BlocksUpTo(key);
+  if (blocks == 0) { return 0; }
+  bool found;
+  return ScanBlock(blocks - 1, key, &found);
+}
+
+size_t StringDict::Find(string_view key) const {
+  size_t blocks = BlocksUpTo(key);
+  if (blocks == 0) { return npos; }
+  bool found;
+  size_t i = ScanBlock(blocks - 1, key, &found);
+  return found ? i : npos;
+}
+
+string_view StringDict::Key(size_t i, std::string* buffer) const {
+  if (i >= count_) { return string_view(); }
+  size_t block = i / block_size_;
+  if (i % block_size_ == 0) { return BlockHead(block); }
+  string_view s = Block(block);
+  buffer->clear();
+  for (size_t k = 0; k <= i % block_size_; ++k) {
+    if (!ReadKey(&s, buffer)) {
+      buffer->clear();
+      break;
+    }
+  }
+  return *buffer;
+}
+
+string_view StringDict::Value(size_t i) const {
+  if (i >= count_) { return string_view(); }
+  uint32_t begin = Load32(value_offsets_ + 4 * i);
+  uint32_t end = Load32(value_offsets_ + 4 * (i + 1));
+  if (begin > end || end > values_size_) { return string_view(); }
+  return string_view(values_ + begin, end - begin);
+}
+
+bool StringDict::Lookup(string_view key, string_view* value) const {
+  size_t i = Find(key);
+  if (i == npos) { return false; }
+  *value = Value(i);
+  return true;
+}
+
+void StringDictBuilder::Add(string_view key, string_view value) {
+  entries_.emplace_back(std::string(key), std::string(value));
+}
+
+bool StringDictBuilder::Build(std::string* out) {
+  std::sort(entries_.begin(), entries_.end());
+  for (size_t i = 1; i < entries_.size(); ++i) {
+    if (entries_[i - 1].first == entries_[i].first) { return false; }
+  }
+  const size_t count = entries_.size();
+  const size_t block_count = (count + block_size_ - 1) / block_size_;
+  std::string bytes(kMagic, sizeof(kMagic));
+  bytes.resize(kHeaderSize);
+
+  std::vector<uint32_t> block_offsets;
+  for (size_t i = 0; i < count; ++i) {
+    const std::string& key = entries_[i].first;
+    size_t shared = 0;
+    if (i % block_size_ == 0) {
+      if (bytes.size() > kMaxSize) { return false; }
+      block_offsets.push_back(static_cast<uint32_t>(bytes.size()));
+    } else {
+      const std::string& before = entries_[i - 1].first;
+      size_t limit = std::min(before.size(), key.size());
+      while (shared < limit && before[shared] == key[shared]) { ++shared; }
+    }
+    if (key.size() > kMaxSize) { return false; }
+    AppendVarint(static_cast<uint32_t>(shared), &bytes);
+    AppendVarint(static_cast<uint32_t>(key.size() - shared), &bytes);
+    bytes.append(key, shared, std::string::npos);
+  }
+  if (bytes.size() > kMaxSize) { return false; }
+  block_offsets.push_back(static_cast<uint32_t>(bytes.size()));
+
+  const uint64_t index_offset = bytes.size();
+  for (uint32_t offset : block_offsets) { Append32(offset, &bytes); }
+  const uint64_t values_offset = bytes.size();
+  uint64_t value_offset = 0;
+  for (const auto& entry : entries_) {
+    Append32(static_cast<uint32_t>(value_offset), &bytes);
+    value_offset += entry.second.size();
+    if (value_offset > kMaxSize) { return false; }
+  }
+  Append32(static_cast<uint32_t>(value_offset), &bytes);
+  for (const auto& entry : entries_) { bytes += entry.second; }
+  if (bytes.size() > kMaxSize) { return false; }
+
+  char* header = &bytes[sizeof(kMagic)];
+  Store32(static_cast<uint32_t>(count), header);
+  Store32(static_cast<uint32_t>(block_size_), header + 4);
+  Store32(static_cast<uint32_t>(block_count), header + 8);
+  Store32(static_cast<uint32_t>(index_offset), header + 12);
+  Store32(static_cast<uint32_t>(values_offset), header + 16);
+  Store32(static_cast<uint32_t>(bytes.size()), header + 20);
+  out->swap(bytes);
+  return true;
+}
+
+}  // namespace absl
@@ -0,0 +1,108 @@
+#ifndef ABSL_STRING_DICT_H_
+#define ABSL_STRING_DICT_H_
+
+#include <vector>
+
+#include "absl/string_view.h"
+
+namespace absl {
+
+// A read-only sorted dictionary of strings, each with an optional value,
+// in a flat format which is written once by a build tool and used in
+// place, e.g. from a memory mapped file, without any parsing.
+//
+//   // The build tool.
+//   absl::StringDictBuilder builder;
+//   builder.Add("item.sword", "Sword");
+//   std::string bytes;
+//   builder.Build(&bytes);
+//
+//   // At runtime, over a base::MappedFile.
+//   absl::StringDict dict;
+//   if (!dict.Init(file.data())) { ... }
+//   absl::string_view name;
+//   if (dict.Lookup("item.sword", &name)) { ... }
+//
+// The keys are front coded in blocks: the first key of a block is stored
+// whole, the others as the length of the prefix they share with the key
+// before and the rest. A binary search over the first keys, which are
+// views into the data, finds the block; the block is decoded up to the
+// key. Values are stored whole and returned as views into the data.
+//
+// The format, all numbers little endian:
+//   header        magic "XSDICT1\n", then uint32 count, block_size,
+//                 block_count, index_offset, values_offset and size
+//   blocks        per key: varint shared, varint length, the bytes
+//   index         uint32 offsets of the blocks, block_count + 1 of them
+//   values        uint32 offsets of the values, count + 1 of them, from
+//                 the end of this table; then the bytes of the values
+class StringDict {
+ public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  StringDict() { }
+  // Uses the dictionary in data, which must outlive this object. Returns
+  // false if data does not hold a well formed header whose tables fit in
+  // it. Only the header is read; the offsets are checked as they are used,
+  // so a corrupted block only makes its keys unfindable, and a corrupted
+  // value offset its value empty.
+  bool Init(string_view data);
+
+  size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+
+  // The index of key in the sorted order, or npos if it is not there.
+  size_t Find(string_view key) const;
+  // The index of the first key which is not less than key, or size().
+  size_t LowerBound(string_view key) const;
+  // The key at index i. The view is into the data for the first key of a
+  // block, and into *buffer otherwise.
+  string_view Key(size_t i, std::string* buffer) const;
+  // The value at index i, a view into the data.
+  string_view Value(size_t i) const;
+  // Finds the value of key. Returns false if key is not there.
+  bool Lookup(string_view key, string_view* value) const;
+
+ private:
+  // The number of blocks whose first key is not greater than key.
+  size_t BlocksUpTo(string_view key) const;
+  // Scans the block for key. Returns the index of the first key which is
+  // not less than key, and whether it is key.
+  size_t ScanBlock(size_t block, string_view key, bool* found) const;
+  string_view BlockHead(size_t block) const;
+  string_view Block(size_t block) const;
+
+  string_view data_;
+  size_t count_ = 0;
+  size_t block_size_ = 1;
+  size_t block_count_ = 0;
+  const char* index_ = nullptr;
+  const char* value_offsets_ = nullptr;
+  const char* values_ = nullptr;
+  // Where the blocks end, and the size of the bytes of the values.
+  size_t blocks_end_ = 0;
+  size_t values_size_ = 0;
+};
+
+class StringDictBuilder {
+ public:
+  // block_size keys share a block; larger blocks are smaller and slower.
+  explicit StringDictBuilder(size_t block_size = 16)
+      : block_size_(block_size == 0 ? 1 : block_size) { }
+
+  void Add(string_view key, string_view value = string_view());
+  size_t size() const { return entries_.size(); }
+
+  // Sorts the keys added so far and writes their dictionary to *out.
+  // Returns false if a key was added twice or the dictionary would not fit
+  // in 4GB.
+  bool Build(std::string* out);
+
+ private:
+  size_t block_size_;
+  std::vector<std::pair<std::string, std::string>> entries_;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRING_DICT_H_
@@ -0,0 +1,242 @@
+#include "absl/string_sort.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace absl {
+
+namespace {
+
+// A string with 8 of its bytes from depth, big endian so that the keys
+// compare like the bytes, and padded with zeros past its end.
+struct Item {
+  uint64_t key;
+  string_view s;
+};
+
+inline uint64_t LoadKey(string_view s, size_t depth) {
+  uint64_t key = 0;
+  if (s.size() >= depth + sizeof(key)) {
+    memcpy(&key, s.data() + depth, sizeof(key));
+  } else if (s.size() > depth) {
+    memcpy(&key, s.data() + depth, s.size() - depth);
+  }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  key = __builtin_bswap64(key);
+#endif
+  return key;
+}
+
+// Compares the strings from depth, before which they are equal.
+inline bool Less(const Item& a, const Item& b, size_t depth) {
+  if (a.key != b.key) { return a.key < b.key; }
+  string_view x = a.s.substr(std::min(depth, a.s.size()));
+  string_view y = b.s.substr(std::min(depth, b.s.size()));
+  return x.compare(y) < 0;
+}
+
+void InsertionSort(Item* a, size_t n, size_t depth) {
+  for (size_t i = 1; i < n; ++i) {
+    Item item = a[i];
+    size_t j = i;
+    for (; j > 0 && Less(item, a[j - 1], depth); --j) { a[j] = a[j - 1]; }
+    a[j] = item;
+  }
+}
+
+inline uint64_t MedianOf3(uint64_t a, uint64_t b, uint64_t c) {
+  if (a < b) { return b < c ? b : (a < c ? c : a); }
+  return a < c ? a : (b < c ? c : b);
+}
+
+constexpr size_t kInsertionSortSize = 16;
+
+// Sorts a[0, n), whose strings are equal before depth and whose keys hold
+// their bytes from depth. budget bounds the depth of the recursion on the
+// unequal parts, past which std::sort takes over; the loop on the equal
+// part ends with the strings.
+void MultikeyQuicksort(Item* a, size_t n, size_t depth, int budget) {
+  while (n > kInsertionSortSize) {
+    if (budget == 0) {
+      std::sort(a, a + n, [depth](const Item& x, const Item& y) {
+        return Less(x, y, depth);
+      });
+      return;
+    }
+    // Three way partition on the keys.
+    uint64_t pivot = MedianOf3(a[0].key, a[n / 2].key, a[n - 1].key);
+    size_t lt = 0;
+    size_t gt = n;
+    for (size_t i = 0; i < gt;) {
+      if (a[i].key < pivot) {
+        std::swap(a[lt++], a[i++]);
+      } else if (a[i].key > pivot) {
+        std::swap(a[i], a[--gt]);
+      } else {
+        ++i;
+      }
+    }
+    MultikeyQuicksort(a, lt, depth, budget - 1);
+    MultikeyQuicksort(a + gt, n - gt, depth, budget - 1);
+    // Of the strings equal up to depth + 8, those which end there come
+    // first, shortest first: each is a prefix of the longer ones. The
+    // others go on with their next 8 bytes.
+    Item* equal = a + lt;
+    Item* equal_end = a + gt;
+    Item* rest = std::partition(equal, equal_end, [depth](const Item& x) {
+      return x.s.size() <= depth + sizeof(x.key);
+    });
+    std::sort(equal, rest, [](const Item& x, const Item& y) {
+      return x.s.size() < y.s.size();
+    });
+    a = rest;
+    n = static_cast<size_t>(equal_end - rest);
+    depth += sizeof(uint64_t);
+    for (size_t i = 0; i < n; ++i) { a[i].key = LoadKey(a[i].s, depth); }
+  }
+  InsertionSort(a, n, depth);
+}
+
+int Budget(size_t n) {
+  int log = 0;
+  for (; n > 1; n >>= 1) { ++log; }
+  return 2 * log + 4;
+}
+
+void SortItems(Item* a, size_t n) { MultikeyQuicksort(a, n, 0, Budget(n)); }
+
+// Calls f(t) for t in [0, threads) on as many threads.
+template <typename F>
+void RunParallel(int threads, const F& f) {
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads; ++t) { workers.emplace_back(f, t); }
+  f(0);
+  for (auto& worker : workers) { worker.join(); }
+}
+
+// Inputs below this are not worth the threads.
+constexpr size_t kMinParallelSize = 1 << 16;
+
+void SortSequential(std::vector<string_view>* strings) {
+  const size_t n = strings->size();
+  std::vector<Item> items(n);
+  for (size_t i = 0; i < n; ++i) {
+    items[i] = Item{LoadKey((*strings)[i], 0), (*strings)[i]};
+  }
+  SortItems(items.data(), n);
+  for (size_t i = 0; i < n; ++i) { (*strings)[i] = items[i].s; }
+}
+
+// A sample sort: the items are spread into buckets of key ranges by
+// splitters drawn from a sample, the buckets sorted on their own.
+void SortParallel(std::vector<string_view>* strings, int threads) {
+  const size_t n = strings->size();
+  const size_t bucket_count = 8 * static_cast<size_t>(threads);
+  const size_t chunk = (n + threads - 1) / threads;
+  auto chunk_range = [n, chunk](int t) {
+    return std::make_pair(std::min(n, t * chunk),
+                          std::min(n, (t + 1) * chunk));
+  };
+
+  // Splitters from an evenly spaced sample of the keys.
+  const size_t sample_size = std::min(n, bucket_count * 64);
+  std::vector<uint64_t> sample(sample_size);
+  for (size_t i = 0; i < sample_size; ++i) {
+    sample[i] = LoadKey((*strings)[i * (n / sample_size)], 0);
+  }
+  std::sort(sample.begin(), sample.end());
+  std::vector<uint64_t> splitters;
+  for (size_t b = 1; b < bucket_count; ++b) {
+    splitters.push_back(sample[b * sample_size / bucket_count]);
+  }
+  splitters.erase(std::unique(splitters.begin(), splitters.end()),
+                  splitters.end());
+  const size_t buckets = splitters.size() + 1;
+
+  // Each thread loads the keys of its chunk, finds their buckets and counts
+  // them, then moves them to their places.
+  std::vector<Item> items(n);
+  std::vector<uint32_t> bucket_of(n);
+  std::vector<size_t> counts(threads * buckets);
+  RunParallel(threads, [&](int t) {
+    auto range = chunk_range(t);
+    size_t* count = &counts[t * buckets];
+    for (size_t i = range.first; i < range.second; ++i) {
+      string_view s = (*strings)[i];
+      items[i] = Item{LoadKey(s, 0), s};
+      // Keys equal to a splitter go above it, so equal keys share a bucket.
+      uint32_t b = static_cast<uint32_t>(
+          std::upper_bound(splitters.begin(), splitters.end(), items[i].key) -
+          splitters.begin());
+      bucket_of[i] = b;
+      ++count[b];
+    }
+  });
+  // The place of the first item of thread t in bucket b, bucket by bucket.
+  std::vector<size_t> offsets(threads * buckets);
+  std::vector<size_t> bucket_begin(buckets + 1);
+  size_t offset = 0;
+  for (size_t b = 0; b < buckets; ++b) {
+    bucket_begin[b] = offset;
+    for (int t = 0; t < threads; ++t) {
+      offsets[t * buckets + b] = offset;
+      offset += counts[t * buckets + b];
+    }
+  }
+  bucket_begin[buckets] = n;
+  std::vector<Item> sorted(n);
+  RunParallel(threads, [&](int t) {
+    auto range = chunk_range(t);
+    size_t* next = &offsets[t * buckets];
+    for (size_t i = range.first; i < range.second; ++i) {
+      sorted[next[bucket_of[i]]++] = items[i];
+    }
+  });
+
+  // The buckets, largest first, go to whichever thread is free.
+  std::vector<uint32_t> order(buckets);
+  for (size_t b = 0; b < buckets; ++b) { order[b] = static_cast<uint32_t>(b); }
+  std::sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) {
+    return bucket_begin[x + 1] - bucket_begin[x] >
+           bucket_begin[y + 1] - bucket_begin[y];
+  });
+  std::atomic<size_t> next_bucket{0};
+  RunParallel(threads, [&](int) {
+    for (size_t k = next_bucket++; k < buckets; k = next_bucket++) {
+      size_t b = order[k];
+      SortItems(&sorted[bucket_begin[b]],
+                bucket_begin[b + 1] - bucket_begin[b]);
+    }
+  });
+  RunParallel(threads, [&](int t) {
+    auto range = chunk_range(t);
+    for (size_t i = range.first; i < range.second; ++i) {
+      (*strings)[i] = sorted[i].s;
+    }
+  });
+}
+}  // namespace
+
+void SortStrings(std::vector<string_view>* strings) {
+  SortSequential(strings);
+}
+
+void ParallelSortStrings(std::vector<string_view>* strings, int threads) {
+  if (threads <= 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (threads == 1 || strings->size() < kMinParallelSize) {
+    SortSequential(strings);
+  } else {
+    SortParallel(strings, threads);
+  }
+}
+
+void SortUniqueStrings(std::vector<string_view>* strings, int threads) {
+  ParallelSortStrings(strings, threads);
+  strings->erase(std::unique(strings->begin(), strings->end()),
+                 strings->end());
+}
+
+}  // namespace absl
@@ -1,118 +1,69 @@
 #include "absl/string_view.h"
 
-#include <cassert>
 #include <cstring>
 
-namespace absl {
-
-constexpr string_view::size_type string_view::npos;
-
-string_view::string_view(const char* s) : ptr_(s), length_(0) {
-  if (s != nullptr) length_ = static_cast<size_type>(strlen(s));
-}
-
-char string_view::at(size_type pos) const {
-  assert(pos < length_);
-  return *(ptr_ + pos);
-}
-
-char string_view::back() const {
-  assert(length_ > 0);
-  return *(ptr_ + length_ - 1);
-}
+#include "absl/char_search.h"
+#include "absl/searcher.h"
 
-string_view::size_type string_view::copy(
-    char* dest, size_type n, size_type pos) const {
-  if (pos > length_) { pos = length_; }
-  if (n > length_ - pos) { n = length_ - pos; }
-  memcpy(dest, ptr_ + pos, n);
-  return n;
-}
+namespace absl {
 
-int string_view::compare(string_view s) const {
-  auto res = memcmp(ptr_, s.ptr_, std::min(length_, s.length_));
-  if (res != 0) { return res < 0 ? -1 : 1; }
-  return length_ == s.length_ ? 0 : (length_ < s.length_ ? -1 : 1);
-}
+using search_internal::CharSet;
+using search_internal::GetSearchKernels;
 
-static const char* Match(
-    const char* ph, size_t hlen, const char* pn, size_t nlen) {
-  if (0 == nlen) { return ph; }
-  if (hlen < nlen) { return nullptr; }
-  const char* m;
-  const char* hend = ph + hlen - nlen + 1;
-  while ((m = static_cast<const char*>(memchr(ph, pn[0], hend - ph)))) {
-    if (memcmp(m, pn, nlen) == 0) { return m; }
-    ph = m + 1;
-  }
-  return nullptr;
-}
+// The vectorized search verifies every candidate window, which degrades on
+// repetitive text as the needle grows. Long needles in long haystacks go to
+// the Two-Way search instead, which is linear in the worst case.
+static constexpr string_view::size_type kMaxKernelNeedle = 32;
+static constexpr string_view::size_type kMinTwoWayHaystack = 256;
 
 string_view::size_type string_view::find(string_view s, size_type pos) const {
   if (empty() || pos >= length_) {
     if (empty() && pos == 0 && s.empty()) { return 0; }
     return npos;
   }
-  auto* res = Match(ptr_ + pos, length_ - pos, s.ptr_, s.length_);
-  return res ? res - ptr_ : npos;
-}
-
-string_view::size_type string_view::find(char c, size_type pos) const {
-  if (empty() || pos >= length_) { return npos; }
-  auto* res = static_cast<const char*>(memchr(ptr_ + pos, c, length_ - pos));
-  return res ? res - ptr_ : npos;
+  if (s.empty()) { return pos; }
+  auto n = length_ - pos;
+  auto res = s.length_ > kMaxKernelNeedle && n >= kMinTwoWayHaystack
+      ? search_internal::TwoWayFind(string_view(ptr_ + pos, n), s)
+      : GetSearchKernels().find_substring(ptr_ + pos, n, s.ptr_, s.length_);
+  return res == npos ? npos : pos + res;
 }
 
 string_view::size_type string_view::rfind(string_view s, size_type pos) const {
   if (length_ < s.length_) { return npos; }
   if (s.empty()) { return std::min(length_, pos); }
-  const char* last = ptr_ + std::min(length_ - s.length_, pos) + s.length_;
+  if (s.length_ == 1) { return rfind(s.front(), pos); }
+  auto window = std::min(length_ - s.length_, pos) + s.length_;
+  if (window >= kMinTwoWayHaystack) {
+    return search_internal::TwoWayRFind(string_view(ptr_, window), s);
+  }
+  const char* last = ptr_ + window;
   const char* res = std::find_end(ptr_, last, s.ptr_, s.ptr_ + s.length_);
   return res != last ? res - ptr_ : npos;
 }
 
 string_view::size_type string_view::rfind(char c, size_type pos) const {
   if (empty()) { return npos; }
-  for (auto i = std::min(pos, length_ - 1); i > 0; --i) {
-    if (ptr_[i] == c) { return i; }
-  }
-  return ptr_[0] == c ? 0 : npos;
+  return GetSearchKernels().find_last_byte(
+      ptr_, std::min(pos, length_ - 1) + 1, c);
 }
 
-namespace {
-class LookupTable {
- public:
-  explicit LookupTable(string_view s) {
-    for (char c : s) { table_[Index(c)] = true; }
-  }
-  bool operator[](char c) const { return table_[Index(c)]; }
-
- private:
-  static unsigned char Index(char c) { return static_cast<unsigned char>(c); }
-  bool table_[256] = {};
-};
-}  // namespace
-
 string_view::size_type string_view::find_first_of(
     string_view s, size_type pos) const {
   if (empty() || s.empty()) { return npos; }
   if (s.length_ == 1) { return find_first_of(s.front(), pos); }
-  LookupTable table(s);
-  for (auto i = pos; i < length_; ++i) {
-    if (table[ptr_[i]]) { return i; }
-  }
-  return npos;
+  if (pos >= length_) { return npos; }
+  auto res = GetSearchKernels().find_first_of(
+      ptr_ + pos, length_ - pos, CharSet(s), false);
+  return res == npos ? npos : pos + res;
 }
 
 string_view::size_type string_view::find_last_of(
     string_view s, size_type pos) const {
   if (empty() || s.empty()) { return npos; }
   if (s.length_ == 1) { return find_last_of(s.front(), pos); }
-  LookupTable table(s);
-  for (auto i = std::min(pos, length_ - 1); i > 0; --i) {
-    if (table[ptr_[i]]) { return i; }
-  }
-  return table[ptr_[0]] ? 0 : npos;
+  return GetSearchKernels().find_last_of(
+      ptr_, std::min(pos, length_ - 1) + 1, CharSet(s), false);
 }
 
 string_view::size_type string_view::find_first_not_of(
@@ -120,20 +71,18 @@ string_view::size_type string_view::find_first_not_of(
   if (empty()) { return npos; }
   if (s.empty()) { return pos >= length_ ? npos : pos; }
   if (s.length_ == 1) { return find_first_not_of(s.front(), pos); }
-  LookupTable table(s);
-  for (auto i = pos; i < length_; ++i) {
-    if (!table[ptr_[i]]) { return i; }
-  }
-  return npos;
+  if (pos >= length_) { return npos; }
+  auto res = GetSearchKernels().find_first_of(
+      ptr_ + pos, length_ - pos, CharSet(s), true);
+  return res == npos ? npos : pos + res;
 }
 
 string_view::size_type string_view::find_first_not_of(
     char c, size_type pos) const {
-  if (empty()) { return npos; }
-  for (auto i = pos; i< length_; ++i) {
-    if (ptr_[i] != c) { return i; }
-  }
-  return npos;
+  if (empty() || pos >= length_) { return npos; }
+  auto res = GetSearchKernels().find_first_not_byte(
+      ptr_ + pos, length_ - pos, c);
+  return res == npos ? npos : pos + res;
 }
 
 string_view::size_type string_view::find_last_not_of(
@@ -141,20 +90,15 @@ string_view::size_type string_view::find_last_not_of(
   if (empty()) { return npos; }
   if (s.empty()) { return std::min(pos, length_ - 1); }
   if (s.length_ == 1) { return find_last_not_of(s.front(), pos); }
-  LookupTable table(s);
-  for (auto i = std::min(pos, length_ - 1); i > 0; --i) {
-    if (!table[ptr_[i]]) { return i; }
-  }
-  return !table[ptr_[0]] ? 0 : npos;
+  return GetSearchKernels().find_last_of(
+      ptr_, std::min(pos, length_ - 1) + 1, CharSet(s), true);
 }
 
 string_view::size_type string_view::find_last_not_of(
     char c, size_type pos) const {
   if (empty()) { return npos; }
-  for (auto i = std::min(pos, length_ - 1); i > 0; --i) {
-    if (ptr_[i] != c) { return i; }
-  }
-  return ptr_[0] != c ? 0 : npos;
+  return GetSearchKernels().find_last_not_byte(
+      ptr_, std::min(pos, length_ - 1) + 1, c);
 }
 
 static void WritePad(std::ostream& os, size_t pad) {
@@ -1,6 +1,9 @@
 #ifndef ABSL_STRING_VIEW_H_
 #define ABSL_STRING_VIEW_H_
 
+#include <cassert>
+#include <string>
+
 #include "base/using_std.h"
 
 namespace absl {
@@ -14,90 +17,128 @@ class string_view {
   using reverse_iterator = const_reverse_iterator;
   using reference = char;
 
-  string_view() { }
-  string_view(const ::std::string& s) : ptr_(s.data()), length_(s.size()) { }
-  string_view(const char* s, size_type n) : ptr_(s), length_(n) { }
-  string_view(const char *s);
-  
-  const string_view& operator=(const string_view& s) {
-    ptr_ = s.ptr_;
-    length_ = s.length_;
-  }
-
-  iterator begin() const { return ptr_; }
-  const_iterator cbegin() const { return ptr_; }
-  iterator end() const { return ptr_ + length_; }
-  const_iterator cend() const { return ptr_ + length_; }
-  reverse_iterator rbegin() const { return reverse_iterator(end()); }
-  const_reverse_iterator crbegin() const {
+  // The trivial operations are constexpr and inline, so views of literals
+  // and comparisons between them fold at compile time. The searches which
+  // use the vectorized kernels are out of line.
+  constexpr string_view() noexcept { }
+  string_view(const ::std::string& s) noexcept
+      : ptr_(s.data()), length_(s.size()) { }
+  constexpr string_view(const char* s, size_type n) noexcept
+      : ptr_(s), length_(n) { }
+  constexpr string_view(const char* s)
+      : ptr_(s), length_(s != nullptr ? Traits::length(s) : 0) { }
+  constexpr string_view(const string_view&) noexcept = default;
+  constexpr string_view& operator=(const string_view&) noexcept = default;
+  explicit operator ::std::string() const {
+    return ::std::string(ptr_, length_);
+  }
+
+  constexpr iterator begin() const { return ptr_; }
+  constexpr const_iterator cbegin() const { return ptr_; }
+  constexpr iterator end() const { return ptr_ + length_; }
+  constexpr const_iterator cend() const { return ptr_ + length_; }
+  constexpr reverse_iterator rbegin() const {
+    return reverse_iterator(end());
+  }
+  constexpr const_reverse_iterator crbegin() const {
     return const_reverse_iterator(cend());
   }
-  reverse_iterator rend() const { return reverse_iterator(begin()); }
-  const_reverse_iterator crend() const {
+  constexpr reverse_iterator rend() const {
+    return reverse_iterator(begin());
+  }
+  constexpr const_reverse_iterator crend() const {
     return const_reverse_iterator(cbegin());
   }
 
-  reference operator[](size_type pos) const { return at(pos); }
-  reference at(size_type pos) const;
-  reference front() const { return at(0); }
-  reference back() const;
+  constexpr reference operator[](size_type pos) const { return at(pos); }
+  constexpr reference at(size_type pos) const {
+    assert(pos < length_);
+    return ptr_[pos];
+  }
+  constexpr reference front() const { return at(0); }
+  constexpr reference back() const { return at(length_ - 1); }
 
-  const char* data() const { return ptr_; }
-  size_type length() const { return length_; }
-  size_type size() const { return length_; }
-  size_type max_size() const { return length_; }
-  bool empty() const { return length_ == 0; }
+  constexpr const char* data() const { return ptr_; }
+  constexpr size_type length() const { return length_; }
+  constexpr size_type size() const { return length_; }
+  constexpr size_type max_size() const { return length_; }
+  constexpr bool empty() const { return length_ == 0; }
 
-  void remove_prefix(size_type n) {
+  constexpr void remove_prefix(size_type n) {
     if (n > length_) { n = length_; }
     ptr_ += n;
     length_ -= n;
   }
-  void remove_suffix(size_type n) {
+  constexpr void remove_suffix(size_type n) {
     if (n > length_) { n = length_; }
     length_ -= n;
   }
-  void swap(string_view &other) {
-    ::std::swap(ptr_, other.ptr_);
-    ::std::swap(length_, other.length_);
+  constexpr void swap(string_view &other) {
+    string_view tmp = *this;
+    *this = other;
+    other = tmp;
   }
 
-  size_type copy(char* dest, size_type n, size_type pos = 0) const;
-  string_view substr(size_type pos = 0, size_type n = npos) const {
+  size_type copy(char* dest, size_type n, size_type pos = 0) const {
+    if (pos > length_) { pos = length_; }
+    if (n > length_ - pos) { n = length_ - pos; }
+    Traits::copy(dest, ptr_ + pos, n);
+    return n;
+  }
+  constexpr string_view substr(size_type pos = 0, size_type n = npos) const {
     if (pos > length_) { pos = length_; }
     if (n > length_ - pos) { n = length_ - pos; }
     return n > 0 ? string_view(ptr_ + pos, n) : string_view();
   }
-  int compare(string_view s) const;
-  int compare(size_type pos, size_type n, string_view s) const {
+  constexpr int compare(string_view s) const {
+    int res = Traits::compare(ptr_, s.ptr_, Min(length_, s.length_));
+    if (res != 0) { return res < 0 ? -1 : 1; }
+    return length_ == s.length_ ? 0 : (length_ < s.length_ ? -1 : 1);
+  }
+  constexpr int compare(size_type pos, size_type n, string_view s) const {
     return substr(pos, n).compare(s);
   }
-  int compare(size_type pos1, size_type n1, string_view s, size_type pos2,
-              size_type n2) const {
+  constexpr int compare(size_type pos1, size_type n1, string_view s,
+                        size_type pos2, size_type n2) const {
     return substr(pos1, n1).compare(s.substr(pos2, n2));
   }
-  int compare(const char* s) const { return compare(string_view(s)); }
-  int compare(size_type pos, size_type n, const char* s) const {
+  constexpr int compare(const char* s) const {
+    return compare(string_view(s));
+  }
+  constexpr int compare(size_type pos, size_type n, const char* s) const {
     return substr(pos, n).compare(string_view(s));
   }
-  int compare(size_type pos1, size_type n1, const char* s, size_type n2) const {
+  constexpr int compare(size_type pos1, size_type n1, const char* s,
+                        size_type n2) const {
     return substr(pos1, n1).compare(string_view(s, n2));
   }
 
-  bool starts_with(string_view s) const {
+  constexpr bool starts_with(string_view s) const {
     return length_ >= s.length_ && substr(0, s.length_).compare(s) == 0;
   }
-  bool starts_with(char c) const { return length_ > 0 && front() == c; }
-  bool starts_with(const char* s) const { return starts_with(string_view(s)); }
-  bool ends_with(string_view s) const {
+  constexpr bool starts_with(char c) const {
+    return length_ > 0 && front() == c;
+  }
+  constexpr bool starts_with(const char* s) const {
+    return starts_with(string_view(s));
+  }
+  constexpr bool ends_with(string_view s) const {
     return length_ >= s.length_ &&
            substr(length_ - s.length_, s.length_).compare(s) == 0;
   }
-  bool ends_with(char c) const { return length_ > 0 && back() == c; }
-  bool ends_with(const char* s) const { return ends_with(string_view(s)); }
+  constexpr bool ends_with(char c) const {
+    return length_ > 0 && back() == c;
+  }
+  constexpr bool ends_with(const char* s) const {
+    return ends_with(string_view(s));
+  }
 
   size_type find(string_view s, size_type pos = 0) const;
-  size_type find(char c, size_type pos = 0) const;
+  constexpr size_type find(char c, size_type pos = 0) const {
+    if (pos >= length_) { return npos; }
+    const char* res = Traits::find(ptr_ + pos, length_ - pos, c);
+    return res != nullptr ? res - ptr_ : npos;
+  }
   size_type find(const char *s, size_type pos, size_type n) const {
     return find(string_view(s, n), pos);
   }
@@ -115,7 +156,7 @@ class string_view {
   }
 
   size_type find_first_of(string_view s, size_type pos = 0) const;
-  size_type find_first_of(char c, size_type pos = 0) const {
+  constexpr size_type find_first_of(char c, size_type pos = 0) const {
     return find(c, pos);
   }
   size_type find_first_of(const char* s, size_type pos, size_type n) const {
@@ -157,27 +198,31 @@ class string_view {
   static constexpr size_type npos = size_type(-1);
 
  private:
-  size_type Strlen(const char*s);
+  using Traits = ::std::char_traits<char>;
+  static constexpr size_type Min(size_type a, size_type b) {
+    return a < b ? a : b;
+  }
+
   const char* ptr_ = nullptr;
   size_type length_ = 0;
 };
 
-inline bool operator==(string_view lhs, string_view rhs) {
+constexpr bool operator==(string_view lhs, string_view rhs) {
   return lhs.compare(rhs) == 0;
 }
-inline bool operator!=(string_view lhs, string_view rhs) {
+constexpr bool operator!=(string_view lhs, string_view rhs) {
   return !(lhs == rhs);
 }
-inline bool operator<(string_view lhs, string_view rhs) {
+constexpr bool operator<(string_view lhs, string_view rhs) {
   return lhs.compare(rhs) < 0;
 }
-inline bool operator<=(string_view lhs, string_view rhs) {
+constexpr bool operator<=(string_view lhs, string_view rhs) {
   return !(rhs < lhs);
 }
-inline bool operator>(string_view lhs, string_view rhs) {
+constexpr bool operator>(string_view lhs, string_view rhs) {
   return rhs < lhs;
 }
-inline bool operator>=(string_view lhs, string_view rhs) {
+constexpr bool operator>=(string_view lhs, string_view rhs) {
   return !(lhs < rhs);
 }
 
@@ -0,0 +1,403 @@
+#include "absl/utf8.h"
+
+#include "absl/cpu_features.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ABSL_UTF8_X86 1
+#include <immintrin.h>
+#endif
+
+namespace absl {
+
+namespace {
+using search_internal::SearchIsa;
+
+// The length of the well formed sequence at the start of p, after table
+// 3-7 of the Unicode standard, or 0 if there is none.
+size_t SequenceLength(const unsigned char* p, size_t n) {
+  const unsigned char b = p[0];
+  if (b < 0x80) { return 1; }
+  if (b < 0xc2) { return 0; }
+  auto continues = [p, n](size_t i, unsigned char low, unsigned char high) {
+    return i < n && p[i] >= low && p[i] <= high;
+  };
+  if (b < 0xe0) { return continues(1, 0x80, 0xbf) ? 2 : 0; }
+  if (b < 0xf0) {
+    // No overlong forms after E0, no surrogates after ED.
+    const unsigned char low = b == 0xe0 ? 0xa0 : 0x80;
+    const unsigned char high = b == 0xed ? 0x9f : 0xbf;
+    return continues(1, low, high) && continues(2, 0x80, 0xbf) ? 3 : 0;
+  }
+  if (b < 0xf5) {
+    // No overlong forms after F0, nothing beyond U+10FFFF after F4.
+    const unsigned char low = b == 0xf0 ? 0x90 : 0x80;
+    const unsigned char high = b == 0xf4 ? 0x8f : 0xbf;
+    return continues(1, low, high) && continues(2, 0x80, 0xbf) &&
+           continues(3, 0x80, 0xbf) ? 4 : 0;
+  }
+  return 0;
+}
+
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+bool ValidateScalar(const char* p, size_t n) {
+  const auto* s = reinterpret_cast<const unsigned char*>(p);
+  size_t i = 0;
+  while (i < n) {
+    // ASCII runs go 8 bytes at a time.
+    if (n - i >= 8) {
+      uint64_t word;
+      memcpy(&word, s + i, sizeof(word));
+      if ((word & kHighBits) == 0) {
+        i += 8;
+        continue;
+      }
+    }
+    size_t length = SequenceLength(s + i, n - i);
+    if (length == 0) { return false; }
+    i += length;
+  }
+  return true;
+}
+
+#ifdef ABSL_UTF8_X86
+
+#define ABSL_TARGET(isa) __attribute__((target(isa)))
+
+// The vectorized validation is the lookup algorithm of Keiser and Lemire,
+// "Validating UTF-8 In Less Than One Instruction Per Byte". Three table
+// lookups, on the high and low nibbles of each byte and the high nibble of
+// the byte after it, flag the errors which show in a pair of bytes; each
+// bit stands for a kind of error, and a pair is wrong if all three tables
+// agree on one. Whether the third and fourth bytes of sequences are
+// continuation bytes is checked apart.
+constexpr uint8_t kTooShort = 1 << 0;
+constexpr uint8_t kTooLong = 1 << 1;
+constexpr uint8_t kOverlong3 = 1 << 2;
+constexpr uint8_t kTooLarge = 1 << 3;
+constexpr uint8_t kSurrogate = 1 << 4;
+constexpr uint8_t kOverlong2 = 1 << 5;
+constexpr uint8_t kTooLarge1000 = 1 << 6;
+constexpr uint8_t kOverlong4 = 1 << 6;
+constexpr uint8_t kTwoConts = 1 << 7;
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+alignas(16) constexpr uint8_t kByte1High[16] = {
+    // 0___ ASCII.
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    // 10__ continuation.
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    // 1100, 1101 two byte lead.
+    kTooShort | kOverlong2,
+    kTooShort,
+    // 1110 three byte lead.
+    kTooShort | kOverlong3 | kSurrogate,
+    // 1111 four byte lead.
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4};
+
+alignas(16) constexpr uint8_t kByte1Low[16] = {
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000};
+
+alignas(16) constexpr uint8_t kByte2High[16] = {
+    // 0___ ASCII.
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    // 1000
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 |
+        kOverlong4,
+    // 1001
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    // 101_
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    // 11__ lead.
+    kTooShort, kTooShort, kTooShort, kTooShort};
+
+// The last bytes of a block, from which a sequence can run into the next
+// block, are above these.
+alignas(32) constexpr uint8_t kIncompleteLimits[32] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf};
+
+struct Ssse3State {
+  __m128i error;
+  __m128i prev_input;
+  __m128i prev_incomplete;
+};
+
+template <int N>
+ABSL_TARGET("ssse3")
+inline __m128i PrevSsse3(__m128i input, __m128i prev_input) {
+  return _mm_alignr_epi8(input, prev_input, 16 - N);
+}
+
+ABSL_TARGET("ssse3")
+inline __m128i TableSsse3(const uint8_t* t) {
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(t));
+}
+
+ABSL_TARGET("ssse3")
+inline void StepSsse3(__m128i input, Ssse3State* s) {
+  if (_mm_movemask_epi8(input) == 0) {
+    // An ASCII block is fine, unless the last one ended inside a sequence.
+    s->error = _mm_or_si128(s->error, s->prev_incomplete);
+    s->prev_incomplete = _mm_setzero_si128();
+    s->prev_input = input;
+    return;
+  }
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  const __m128i prev1 = PrevSsse3<1>(input, s->prev_input);
+  __m128i byte_1_high = _mm_shuffle_epi8(
+      TableSsse3(kByte1High), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  __m128i byte_1_low = _mm_shuffle_epi8(
+      TableSsse3(kByte1Low), _mm_and_si128(prev1, nibble));
+  __m128i byte_2_high = _mm_shuffle_epi8(
+      TableSsse3(kByte2High), _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+  __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low),
+                                  byte_2_high);
+  // The bytes two after a three or four byte lead, or three after a four
+  // byte lead, must be continuation bytes, which special flags as two
+  // continuations in a row.
+  __m128i third = _mm_subs_epu8(PrevSsse3<2>(input, s->prev_input),
+                                _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+  __m128i fourth = _mm_subs_epu8(PrevSsse3<3>(input, s->prev_input),
+                                 _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+  __m128i must_continue = _mm_and_si128(
+      _mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+  s->error = _mm_or_si128(s->error, _mm_xor_si128(must_continue, special));
+  s->prev_incomplete = _mm_subs_epu8(
+      input, _mm_loadu_si128(
+                 reinterpret_cast<const __m128i*>(kIncompleteLimits + 16)));
+  s->prev_input = input;
+}
+
+ABSL_TARGET("ssse3")
+bool ValidateSsse3(const char* p, size_t n) {
+  Ssse3State s = {_mm_setzero_si128(), _mm_setzero_si128(),
+                  _mm_setzero_si128()};
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    StepSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), &s);
+  }
+  // The tail, padded with zeros, which end any sequence left open.
+  alignas(16) char tail[16] = {};
+  memcpy(tail, p + i, n - i);
+  StepSsse3(_mm_load_si128(reinterpret_cast<const __m128i*>(tail)), &s);
+  __m128i error = _mm_or_si128(s.error, s.prev_incomplete);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) ==
+         0xffff;
+}
+
+struct Avx2State {
+  __m256i error;
+  __m256i prev_input;
+  __m256i prev_incomplete;
+};
+
+// The bytes of input N places back, across the two lanes and into the
+// previous block.
+template <int N>
+ABSL_TARGET("avx2")
+inline __m256i PrevAvx2(__m256i input, __m256i prev_input) {
+  return _mm256_alignr_epi8(
+      input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+ABSL_TARGET("avx2")
+inline __m256i TableAvx2(const uint8_t* t) {
+  return _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(t)));
+}
+
+ABSL_TARGET("avx2")
+inline void StepAvx2(__m256i input, Avx2State* s) {
+  if (_mm256_movemask_epi8(input) == 0) {
+    s->error = _mm256_or_si256(s->error, s->prev_incomplete);
+    s->prev_incomplete = _mm256_setzero_si256();
+    s->prev_input = input;
+    return;
+  }
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  const __m256i prev1 = PrevAvx2<1>(input, s->prev_input);
+  __m256i byte_1_high = _mm256_shuffle_epi8(
+      TableAvx2(kByte1High),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+  __m256i byte_1_low = _mm256_shuffle_epi8(
+      TableAvx2(kByte1Low), _mm256_and_si256(prev1, nibble));
+  __m256i byte_2_high = _mm256_shuffle_epi8(
+      TableAvx2(kByte2High),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+  __m256i special = _mm256_and_si256(
+      _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+  __m256i third = _mm256_subs_epu8(
+      PrevAvx2<2>(input, s->prev_input),
+      _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+  __m256i fourth = _mm256_subs_epu8(
+      PrevAvx2<3>(input, s->prev_input),
+      _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+  __m256i must_continue = _mm256_and_si256(
+      _mm256_or_si256(third, fourth),
+      _mm256_set1_epi8(static_cast<char>(0x80)));
+  s->error = _mm256_or_si256(s->error,
+                             _mm256_xor_si256(must_continue, special));
+  s->prev_incomplete = _mm256_subs_epu8(
+      input, _mm256_load_si256(
+                 reinterpret_cast<const __m256i*>(kIncompleteLimits)));
+  s->prev_input = input;
+}
+
+ABSL_TARGET("avx2")
+bool ValidateAvx2(const char* p, size_t n) {
+  Avx2State s = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                 _mm256_setzero_si256()};
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    StepAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), &s);
+  }
+  alignas(32) char tail[32] = {};
+  memcpy(tail, p + i, n - i);
+  StepAvx2(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), &s);
+  __m256i error = _mm256_or_si256(s.error, s.prev_incomplete);
+  return _mm256_testz_si256(error, error);
+}
+
+#undef ABSL_TARGET
+
+#endif  // ABSL_UTF8_X86
+
+utf8_internal::Validator SelectValidator() {
+  for (SearchIsa isa : {SearchIsa::kAvx2, SearchIsa::kSsse3}) {
+    auto validator = utf8_internal::GetUtf8Validator(isa);
+    if (validator != nullptr) { return validator; }
+  }
+  return ValidateScalar;
+}
+}  // namespace
+
+namespace utf8_internal {
+
+Validator GetUtf8Validator(SearchIsa isa) {
+  const CpuFeatures& cpu = GetCpuFeatures();
+  switch (isa) {
+    case SearchIsa::kScalar:
+      return ValidateScalar;
+#ifdef ABSL_UTF8_X86
+    case SearchIsa::kSsse3:
+      return cpu.ssse3 ? ValidateSsse3 : nullptr;
+    case SearchIsa::kAvx2:
+      return cpu.avx2 ? ValidateAvx2 : nullptr;
+#endif
+    default:
+      // AVX2 runs at memory bandwidth already; there is no AVX-512 kernel.
+      (void) cpu;
+      return nullptr;
+  }
+}
+
+}  // namespace utf8_internal
+
+bool IsValidUtf8(string_view s) {
+  static const utf8_internal::Validator validator = SelectValidator();
+  if (s.empty()) { return true; }
+  return validator(s.data(), s.size());
+}
+
+size_t Utf8Length(string_view s) {
+  // Counts the continuation bytes, 10xxxxxx, 8 at a time.
+  const char* p = s.data();
+  const size_t n = s.size();
+  size_t continuations = 0;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint64_t word;
+    memcpy(&word, p + i, sizeof(word));
+    continuations += __builtin_popcountll(word & ~(word << 1) & kHighBits);
+  }
+  for (; i < n; ++i) {
+    continuations += (static_cast<unsigned char>(p[i]) & 0xc0) == 0x80;
+  }
+  return n - continuations;
+}
+
+size_t DecodeUtf8(string_view s, char32_t* code_point) {
+  const auto* p = reinterpret_cast<const unsigned char*>(s.data());
+  switch (SequenceLength(p, s.size())) {
+    case 1:
+      *code_point = p[0];
+      return 1;
+    case 2:
+      *code_point = (char32_t{p[0] & 0x1fu} << 6) | (p[1] & 0x3f);
+      return 2;
+    case 3:
+      *code_point = (char32_t{p[0] & 0x0fu} << 12) |
+                    (char32_t{p[1] & 0x3fu} << 6) | (p[2] & 0x3f);
+      return 3;
+    case 4:
+      *code_point = (char32_t{p[0] & 0x07u} << 18) |
+                    (char32_t{p[1] & 0x3fu} << 12) |
+                    (char32_t{p[2] & 0x3fu} << 6) | (p[3] & 0x3f);
+      return 4;
+    default:
+      *code_point = kUnicodeReplacement;
+      return 1;
+  }
+}
+
+void AppendUtf8(char32_t c, std::string* out) {
+  if (c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff)) {
+    c = kUnicodeReplacement;
+  }
+  if (c < 0x80) {
+    out->push_back(static_cast<char>(c));
+  } else if (c < 0x800) {
+    out->push_back(static_cast<char>(0xc0 | (c >> 6)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  } else if (c < 0x10000) {
+    out->push_back(static_cast<char>(0xe0 | (c >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  } else {
+    out->push_back(static_cast<char>(0xf0 | (c >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  }
+}
+
+std::string ToValidUtf8(string_view s) {
+  if (IsValidUtf8(s)) { return std::string(s); }
+  std::string out;
+  out.reserve(s.size() + 8);
+  const auto* p = reinterpret_cast<const unsigned char*>(s.data());
+  for (size_t i = 0; i < s.size();) {
+    size_t length = SequenceLength(p + i, s.size() - i);
+    if (length == 0) {
+      AppendUtf8(kUnicodeReplacement, &out);
+      ++i;
+    } else {
+      out.append(s.data() + i, length);
+      i += length;
+    }
+  }
+  return out;
+}
+
+}  // namespace absl
@@ -0,0 +1,109 @@
+#ifndef ABSL_UTF8_H_
+#define ABSL_UTF8_H_
+
+#include <iterator>
+
+#include "absl/char_search.h"
+#include "absl/string_view.h"
+
+namespace absl {
+
+// Whether s is well formed UTF-8: no overlong forms, surrogates, code
+// points beyond U+10FFFF or truncated sequences. It checks 32 or 16 bytes
+// at a time with AVX2 or SSSE3 when the CPU has them.
+bool IsValidUtf8(string_view s);
+
+// The number of code points in s, which must be valid UTF-8; otherwise the
+// count of bytes which are not continuation bytes.
+size_t Utf8Length(string_view s);
+
+constexpr char32_t kUnicodeReplacement = 0xfffd;
+
+// Decodes the code point at the start of s, which must not be empty, into
+// *code_point. Returns its length in bytes, or 1 with kUnicodeReplacement
+// if s does not start with a valid sequence.
+size_t DecodeUtf8(string_view s, char32_t* code_point);
+
+// Appends the UTF-8 form of code_point, or of kUnicodeReplacement if it is
+// not a scalar value, to out.
+void AppendUtf8(char32_t code_point, std::string* out);
+
+// Returns s with each invalid sequence replaced by U+FFFD.
+std::string ToValidUtf8(string_view s);
+
+// The code points of a text, decoded as the range is iterated. Invalid
+// sequences come out as U+FFFD, one per byte.
+//
+//   for (char32_t c : absl::Utf8CodePoints(name)) { ... }
+class Utf8CodePoints {
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = char32_t;
+    using difference_type = ptrdiff_t;
+    using pointer = const char32_t*;
+    using reference = char32_t;
+
+    const_iterator() { }
+    const_iterator(const char* p, const char* end) : p_(p), end_(end) {
+      Decode();
+    }
+    char32_t operator*() const { return code_point_; }
+    const_iterator& operator++() {
+      p_ += length_;
+      Decode();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const const_iterator& other) const {
+      return p_ == other.p_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return p_ != other.p_;
+    }
+    // The bytes of the current code point.
+    const char* position() const { return p_; }
+    size_t length() const { return length_; }
+
+   private:
+    // ASCII is decoded inline.
+    void Decode() {
+      if (p_ == end_) { return; }
+      auto b = static_cast<unsigned char>(*p_);
+      if (b < 0x80) {
+        code_point_ = b;
+        length_ = 1;
+      } else {
+        length_ = DecodeUtf8(string_view(p_, end_ - p_), &code_point_);
+      }
+    }
+
+    const char* p_ = nullptr;
+    const char* end_ = nullptr;
+    char32_t code_point_ = 0;
+    size_t length_ = 0;
+  };
+
+  explicit Utf8CodePoints(string_view s) : s_(s) { }
+  const_iterator begin() const { return const_iterator(s_.begin(), s_.end()); }
+  const_iterator end() const { return const_iterator(s_.end(), s_.end()); }
+
+ private:
+  string_view s_;
+};
+
+namespace utf8_internal {
+// The validator of isa, or nullptr if the CPU does not support it or it
+// has no kernel.
+using Validator = bool (*)(const char* p, size_t n);
+Validator GetUtf8Validator(search_internal::SearchIsa isa);
+}  // namespace utf8_internal
+
+}  // namespace absl
+
+#endif  // ABSL_UTF8_H_
@@ -0,0 +1,273 @@
+#include "base/alloc_tracker.h"
+
+#include <new>
+
+#include "base/logging.h"
+
+namespace base {
+
+namespace {
+constexpr int kMaxAllocTags = 64;
+
+std::mutex tag_mutex;
+std::atomic<int> tag_count{1};
+const char* tag_names[kMaxAllocTags] = { "untagged" };
+
+thread_local int current_tag = 0;
+
+#ifdef XENIA_ALLOC_TRACKING
+// The counters of one thread. Only the owner thread writes them, so relaxed
+// loads and stores do without read-modify-write instructions, while readers
+// on other threads still see whole values.
+struct ThreadCounters {
+  struct Counter {
+    std::atomic<uint64_t> allocs;
+    std::atomic<uint64_t> frees;
+    std::atomic<uint64_t> bytes_allocated;
+    std::atomic<uint64_t> bytes_freed;
+  };
+  Counter counters[kMaxAllocTags];
+  ThreadCounters* next;
+};
+
+// The counters of exited threads stay in the list, so the stats cover the
+// whole life of the process.
+std::atomic<ThreadCounters*> thread_counters_list{nullptr};
+
+thread_local ThreadCounters* thread_counters = nullptr;
+
+ThreadCounters* GetThreadCounters() {
+  if (thread_counters == nullptr) {
+    // Allocated with calloc, which neither recurses into operator new nor
+    // needs constructors for the zeroed atomics.
+    auto* counters =
+        static_cast<ThreadCounters*>(calloc(1, sizeof(ThreadCounters)));
+    if (counters == nullptr) { return nullptr; }
+    counters->next = thread_counters_list.load(std::memory_order_relaxed);
+    while (!thread_counters_list.compare_exchange_weak(
+        counters->next, counters, std::memory_order_release,
+        std::memory_order_relaxed)) { }
+    thread_counters = counters;
+  }
+  return thread_counters;
+}
+
+inline void Increment(std::atomic<uint64_t>* counter, uint64_t n) {
+  counter->store(counter->load(std::memory_order_relaxed) + n,
+                 std::memory_order_relaxed);
+}
+
+// When MaybeLogAllocStats last logged, in steady clock milliseconds.
+std::atomic<int64_t> stats_logged_ms{0};
+#endif  // XENIA_ALLOC_TRACKING
+
+// The interval of MaybeLogAllocStats.
+std::atomic<int> stats_interval_ms{0};
+}  // namespace
+
+int RegisterAllocTag(const char* tag) {
+  std::lock_guard<std::mutex> lock(tag_mutex);
+  int count = tag_count.load(std::memory_order_relaxed);
+  for (int i = 0; i < count; ++i) {
+    if (strcmp(tag_names[i], tag) == 0) { return i; }
+  }
+  if (count == kMaxAllocTags) { return 0; }
+  tag_names[count] = tag;
+  tag_count.store(count + 1, std::memory_order_release);
+  return count;
+}
+
+AllocScope::AllocScope(int tag) : previous_(current_tag) {
+  current_tag = tag;
+}
+
+AllocScope::~AllocScope() {
+  current_tag = previous_;
+}
+
+std::vector<AllocStats> GetAllocStats() {
+  int count = tag_count.load(std::memory_order_acquire);
+  std::vector<AllocStats> stats(count);
+  for (int i = 0; i < count; ++i) { stats[i].tag = tag_names[i]; }
+#ifdef XENIA_ALLOC_TRACKING
+  for (auto* counters = thread_counters_list.load(std::memory_order_acquire);
+       counters != nullptr; counters = counters->next) {
+    for (int i = 0; i < count; ++i) {
+      const auto& counter = counters->counters[i];
+      stats[i].allocs += counter.allocs.load(std::memory_order_relaxed);
+      stats[i].frees += counter.frees.load(std::memory_order_relaxed);
+      stats[i].bytes_allocated +=
+          counter.bytes_allocated.load(std::memory_order_relaxed);
+      stats[i].bytes_freed +=
+          counter.bytes_freed.load(std::memory_order_relaxed);
+    }
+  }
+#endif  // XENIA_ALLOC_TRACKING
+  stats.erase(std::remove_if(stats.begin(), stats.end(),
+                             [](const AllocStats& s) { return s.allocs == 0; }),
+              stats.end());
+  return stats;
+}
+
+void LogAllocStats() {
+  for (const auto& s : GetAllocStats()) {
+    LOG(INFO).With("tag", s.tag)
+        .With("allocs", s.allocs)
+        .With("frees", s.frees)
+        .With("bytes_allocated", s.bytes_allocated)
+        .With("bytes_live", s.bytes_allocated - s.bytes_freed)
+        << "Allocation stats";
+  }
+}
+
+void SetAllocStatsInterval(int interval_ms) {
+  stats_interval_ms.store(interval_ms, std::memory_order_relaxed);
+}
+
+void MaybeLogAllocStats() {
+#ifdef XENIA_ALLOC_TRACKING
+  const int interval_ms = stats_interval_ms.load(std::memory_order_relaxed);
+  if (interval_ms <= 0) { return; }
+  const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  int64_t logged_ms = stats_logged_ms.load(std::memory_order_relaxed);
+  // The first call only starts the clock. Of racing callers, one logs.
+  if (logged_ms != 0 && now_ms - logged_ms < interval_ms) { return; }
+  if (!stats_logged_ms.compare_exchange_strong(logged_ms, now_ms,
+                                               std::memory_order_relaxed)) {
+    return;
+  }
+  if (logged_ms != 0) { LogAllocStats(); }
+#endif  // XENIA_ALLOC_TRACKING
+}
+
+}  // namespace base
+
+#ifdef XENIA_ALLOC_TRACKING
+
+namespace {
+// Every block carries its size and tag in a header in front of it, which is
+// as large as the alignment malloc guarantees. Blocks aligned beyond that
+// are padded to their alignment in front of the header; offset is the
+// padding, to find the start of the malloc block.
+struct alignas(16) AllocHeader {
+  uint64_t size;
+  uint32_t tag;
+  uint32_t offset;
+};
+static_assert(sizeof(AllocHeader) == 16, "unexpected alloc header size");
+
+void* TrackedAlloc(size_t size, size_t alignment = sizeof(AllocHeader)) {
+  void* block = nullptr;
+  size_t offset = 0;
+  if (alignment <= sizeof(AllocHeader)) {
+    block = malloc(sizeof(AllocHeader) + size);
+  } else {
+    // The header goes in the last 16 bytes of the first alignment.
+    offset = alignment - sizeof(AllocHeader);
+    if (size > SIZE_MAX - alignment ||
+        posix_memalign(&block, alignment, alignment + size) != 0) {
+      block = nullptr;
+    }
+  }
+  if (block == nullptr) { return nullptr; }
+  auto* header = reinterpret_cast<AllocHeader*>(
+      static_cast<char*>(block) + offset);
+  header->size = size;
+  header->offset = static_cast<uint32_t>(offset);
+  header->tag = static_cast<uint32_t>(base::current_tag);
+  auto* counters = base::GetThreadCounters();
+  if (counters != nullptr) {
+    auto& counter = counters->counters[header->tag];
+    base::Increment(&counter.allocs, 1);
+    base::Increment(&counter.bytes_allocated, size);
+  }
+  return header + 1;
+}
+
+void TrackedFree(void* p) {
+  if (p == nullptr) { return; }
+  auto* header = static_cast<AllocHeader*>(p) - 1;
+  auto* counters = base::GetThreadCounters();
+  if (counters != nullptr) {
+    auto& counter = counters->counters[header->tag];
+    base::Increment(&counter.frees, 1);
+    base::Increment(&counter.bytes_freed, header->size);
+  }
+  free(reinterpret_cast<char*>(header) - header->offset);
+}
+
+void* TrackedNew(size_t size, size_t alignment = sizeof(AllocHeader)) {
+  while (true) {
+    void* p = TrackedAlloc(size, alignment);
+    if (p != nullptr) { return p; }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) { throw std::bad_alloc(); }
+    handler();
+  }
+}
+
+void* TrackedNewNothrow(size_t size,
+                        size_t alignment = sizeof(AllocHeader)) noexcept {
+  try {
+    return TrackedNew(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+}  // namespace
+
+void* operator new(size_t size) { return TrackedNew(size); }
+void* operator new[](size_t size) { return TrackedNew(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return TrackedNewNothrow(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return TrackedNewNothrow(size);
+}
+void operator delete(void* p) noexcept { TrackedFree(p); }
+void operator delete[](void* p) noexcept { TrackedFree(p); }
+void operator delete(void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  TrackedFree(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  TrackedFree(p);
+}
+
+// The over-aligned forms, which containers of over-aligned types use.
+void* operator new(size_t size, std::align_val_t alignment) {
+  return TrackedNew(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return TrackedNew(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return TrackedNewNothrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return TrackedNewNothrow(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* p, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept {
+  TrackedFree(p);
+}
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  TrackedFree(p);
+}
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+  TrackedFree(p);
+}
+void operator delete(void* p, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  TrackedFree(p);
+}
+void operator delete[](void* p, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  TrackedFree(p);
+}
+
+#endif  // XENIA_ALLOC_TRACKING
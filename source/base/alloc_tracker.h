@@ -0,0 +1,83 @@
+#ifndef BASE_ALLOC_TRACKER_H_
+#define BASE_ALLOC_TRACKER_H_
+
+#include <cstdint>
+
+#include "base/using_std.h"
+
+namespace base {
+
+// The accounting of heap allocations per subsystem. It is compiled in with
+// XENIA_ALLOC_TRACKING, which replaces the global operator new and delete
+// with versions that count into thread local counters. Without it, the
+// ALLOC_SCOPE macro is a no-op and no stats are collected.
+//
+//   void Flush() {
+//     ALLOC_SCOPE("logging");
+//     ...  // Allocations from here on are charged to "logging".
+//   }
+//
+// Memory is charged to the tag which was current when it was allocated,
+// whichever thread frees it.
+
+struct AllocStats {
+  const char* tag;
+  uint64_t allocs;
+  uint64_t frees;
+  uint64_t bytes_allocated;
+  uint64_t bytes_freed;
+};
+
+// Returns the id of tag, which must be a string with static storage. Tags
+// beyond the capacity of the tracker share the id of untagged allocations.
+int RegisterAllocTag(const char* tag);
+
+// Makes tag current for the allocations of this thread until destruction.
+class AllocScope {
+ public:
+  explicit AllocScope(int tag);
+  ~AllocScope();
+  AllocScope(const AllocScope&) = delete;
+  AllocScope& operator=(const AllocScope&) = delete;
+ private:
+  const int previous_;
+};
+
+// What ALLOC_SCOPE declares without XENIA_ALLOC_TRACKING: nothing.
+struct NoAllocScope {
+  explicit constexpr NoAllocScope(const char*) { }
+};
+
+// Returns the stats of all tags which have seen allocations.
+std::vector<AllocStats> GetAllocStats();
+// Logs the stats through the log devices, one structured message per tag.
+void LogAllocStats();
+// Sets how often MaybeLogAllocStats logs, 0 for never.
+void SetAllocStatsInterval(int interval_ms);
+// Logs the stats if the interval has passed since it last did. The caller
+// picks the thread and the time, e.g. once per tick of its main loop, so
+// the stats are logged like any other message. Does nothing in builds
+// without XENIA_ALLOC_TRACKING.
+void MaybeLogAllocStats();
+
+}  // namespace base
+
+#define XENIA_ALLOC_CONCAT_(a, b) a##b
+#define XENIA_ALLOC_CONCAT(a, b) XENIA_ALLOC_CONCAT_(a, b)
+
+// Either way ALLOC_SCOPE is one declaration, of a scope object which lives
+// to the end of the block.
+#ifdef XENIA_ALLOC_TRACKING
+  #define ALLOC_SCOPE(tag) \
+      ::base::AllocScope XENIA_ALLOC_CONCAT(xenia_alloc_scope_, __LINE__)( \
+          [] { \
+            static const int id = ::base::RegisterAllocTag(tag); \
+            return id; \
+          }())
+#else  // XENIA_ALLOC_TRACKING
+  #define ALLOC_SCOPE(tag) \
+      [[maybe_unused]] const ::base::NoAllocScope \
+          XENIA_ALLOC_CONCAT(xenia_alloc_scope_, __LINE__)(tag)
+#endif  // XENIA_ALLOC_TRACKING
+
+#endif  // BASE_ALLOC_TRACKER_H_
@@ -0,0 +1,114 @@
+#include "base/arena.h"
+
+#include <sys/mman.h>
+
+namespace base {
+
+namespace {
+constexpr size_t kHugePageSize = 2 << 20;
+
+// An anonymous mapping of size bytes aligned to 2MB, where the kernel can
+// back it with huge pages, or nullptr.
+void* MapHugePages(size_t size) {
+#ifdef MAP_HUGETLB
+  // Huge pages reserved by the administrator come aligned.
+  void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED) { return p; }
+#endif
+  // Otherwise transparent huge pages, which need the range aligned: more
+  // is mapped, and the ends around the aligned range unmapped.
+  const size_t mapped_size = size + kHugePageSize;
+  void* mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) { return nullptr; }
+  const auto begin = reinterpret_cast<uintptr_t>(mapped);
+  const uintptr_t aligned =
+      (begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  if (aligned > begin) {
+    munmap(mapped, aligned - begin);
+  }
+  const uintptr_t end = begin + mapped_size;
+  if (end > aligned + size) {
+    munmap(reinterpret_cast<void*>(aligned + size), end - aligned - size);
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+  return reinterpret_cast<void*>(aligned);
+}
+}  // namespace
+
+Arena::Arena(const Options& options) : options_(options) { }
+
+Arena::~Arena() {
+  for (const Chunk& chunk : chunks_) { FreeChunk(chunk); }
+}
+
+Arena::Chunk Arena::NewChunk(size_t size) {
+  if (options_.huge_pages) {
+    const size_t rounded = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    if (void* p = MapHugePages(rounded)) {
+      return Chunk{static_cast<char*>(p), rounded, true};
+    }
+  }
+  return Chunk{new char[size], size, false};
+}
+
+void Arena::FreeChunk(const Chunk& chunk) {
+  if (chunk.mapped) {
+    munmap(chunk.data, chunk.size);
+  } else {
+    delete[] chunk.data;
+  }
+}
+
+void Arena::UseChunk(size_t index) {
+  current_ = index;
+  ptr_ = chunks_[index].data;
+  end_ = ptr_ + chunks_[index].size;
+}
+
+void* Arena::AllocateSlow(size_t size, size_t alignment) {
+  if (size > SIZE_MAX - alignment) { throw std::bad_alloc(); }
+  // Room for size bytes however the chunk is aligned.
+  const size_t needed = size + alignment - 1;
+  const size_t next = ptr_ == nullptr ? 0 : current_ + 1;
+  // The next free chunk if it is large enough, or a new one in its place.
+  if (next >= chunks_.size() || chunks_[next].size < needed) {
+    Chunk chunk = NewChunk(std::max(options_.chunk_size, needed));
+    chunks_.insert(chunks_.begin() + next, chunk);
+  }
+  if (ptr_ != nullptr) { bytes_wasted_ += end_ - ptr_; }
+  UseChunk(next);
+  return Allocate(size, alignment);
+}
+
+absl::string_view Arena::CopyString(absl::string_view s) {
+  char* p = static_cast<char*>(Allocate(s.size() + 1, 1));
+  if (!s.empty()) { memcpy(p, s.data(), s.size()); }
+  p[s.size()] = '\0';
+  return absl::string_view(p, s.size());
+}
+
+Arena::Mark Arena::GetMark() const {
+  const size_t offset =
+      ptr_ == nullptr ? 0 : static_cast<size_t>(ptr_ - chunks_[current_].data);
+  return Mark{current_, offset, bytes_used_, bytes_wasted_};
+}
+
+void Arena::Rewind(const Mark& mark) {
+  bytes_used_ = mark.bytes_used;
+  bytes_wasted_ = mark.bytes_wasted;
+  if (chunks_.empty()) { return; }
+  UseChunk(mark.chunk);
+  ptr_ += mark.offset;
+}
+
+ArenaStats Arena::stats() const {
+  ArenaStats stats = {chunks_.size(), 0, bytes_used_, bytes_wasted_};
+  for (const Chunk& chunk : chunks_) { stats.bytes_reserved += chunk.size; }
+  return stats;
+}
+
+}  // namespace base
@@ -0,0 +1,159 @@
+#ifndef BASE_ARENA_H_
+#define BASE_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/string_view.h"
+#include "base/using_std.h"
+
+namespace base {
+
+struct ArenaStats {
+  size_t chunks;
+  // The memory of the chunks.
+  uint64_t bytes_reserved;
+  // The bytes asked for since the last reset.
+  uint64_t bytes_used;
+  // Alignment padding and the ends of chunks too short for an allocation.
+  uint64_t bytes_wasted;
+};
+
+// Memory which is allocated by bumping a pointer through large chunks and
+// freed all at once, for data of a common lifetime like the scratch data of
+// a tick or of a request. Allocating is a few instructions, and freeing
+// nothing until Reset() or Rewind(), which keep the chunks for reuse. It is
+// not thread safe.
+//
+//   base::Arena arena;
+//   while (running) {
+//     auto* events = arena.NewArray<Event>(count);
+//     std::vector<int, base::ArenaAllocator<int>> ids(&arena);
+//     ...
+//     arena.Reset();
+//   }
+//
+// The destructors of the objects in the arena are not run.
+class Arena {
+ public:
+  struct Options {
+    // The size of a chunk; larger allocations get a chunk of their own.
+    size_t chunk_size = 64 << 10;
+    // Backs the chunks with 2MB pages, for large arenas which are touched
+    // all over. The chunks are rounded up to 2MB. Where the system has no
+    // huge pages to give, the chunks come from normal pages.
+    bool huge_pages = false;
+  };
+
+  // Where an arena is, to go back to with Rewind().
+  struct Mark {
+    size_t chunk;
+    size_t offset;
+    uint64_t bytes_used;
+    uint64_t bytes_wasted;
+  };
+
+  Arena() : Arena(Options()) { }
+  explicit Arena(const Options& options);
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // size bytes aligned to alignment, which must be a power of two. Throws
+  // std::bad_alloc, like new, when there is no memory.
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    const auto begin = reinterpret_cast<uintptr_t>(ptr_);
+    const auto end = reinterpret_cast<uintptr_t>(end_);
+    const uintptr_t p = (begin + alignment - 1) & ~(alignment - 1);
+    if (p <= end && size <= end - p && ptr_ != nullptr) {
+      bytes_wasted_ += p - begin;
+      bytes_used_ += size;
+      ptr_ = reinterpret_cast<char*>(p + size);
+      return reinterpret_cast<void*>(p);
+    }
+    return AllocateSlow(size, alignment);
+  }
+
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    return new (Allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+  }
+  // n default initialized objects: trivial types are left uninitialized.
+  template <typename T>
+  T* NewArray(size_t n) {
+    if (n > SIZE_MAX / sizeof(T)) { throw std::bad_alloc(); }
+    return new (Allocate(n * sizeof(T), alignof(T))) T[n];
+  }
+  // A copy of s, NUL terminated.
+  absl::string_view CopyString(absl::string_view s);
+
+  Mark GetMark() const;
+  // Frees everything allocated after mark was taken. Marks taken after it
+  // are no longer valid.
+  void Rewind(const Mark& mark);
+  // Frees everything.
+  void Reset() { Rewind(Mark{0, 0, 0, 0}); }
+
+  ArenaStats stats() const;
+
+ private:
+  struct Chunk {
+    char* data;
+    size_t size;
+    bool mapped;
+  };
+
+  void* AllocateSlow(size_t size, size_t alignment);
+  Chunk NewChunk(size_t size);
+  void FreeChunk(const Chunk& chunk);
+  void UseChunk(size_t index);
+
+  const Options options_;
+  // The chunks in use up to current_, then those free for reuse.
+  std::vector<Chunk> chunks_;
+  size_t current_ = 0;
+  char* ptr_ = nullptr;
+  char* end_ = nullptr;
+  uint64_t bytes_used_ = 0;
+  uint64_t bytes_wasted_ = 0;
+};
+
+// An allocator for standard containers which allocates from an arena, and
+// never frees. Copies of it share the arena.
+//
+//   std::vector<int, base::ArenaAllocator<int>> v(&arena);
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  // Implicit, so that containers can be built from an arena.
+  ArenaAllocator(Arena* arena) : arena_(arena) { }
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) { }
+
+  T* allocate(size_t n) {
+    if (n > SIZE_MAX / sizeof(T)) { throw std::bad_alloc(); }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T*, size_t) { }
+
+  Arena* arena() const { return arena_; }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() == b.arena();
+}
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() != b.arena();
+}
+
+}  // namespace base
+
+#endif  // BASE_ARENA_H_
@@ -0,0 +1,131 @@
+#include "base/command_line_flags.h"
+
+#include <cctype>
+
+#include "absl/numbers.h"
+#include "absl/str_cat.h"
+
+namespace base {
+
+void CommandLineFlags::AddBool(const char* name, bool* value) {
+  flags_.push_back(Flag{name, BOOL, value});
+}
+
+void CommandLineFlags::AddInt(const char* name, int* value) {
+  flags_.push_back(Flag{name, INT, value});
+}
+
+void CommandLineFlags::AddString(const char* name, string* value) {
+  flags_.push_back(Flag{name, STRING, value});
+}
+
+const CommandLineFlags::Flag* CommandLineFlags::Find(
+    const char* name, size_t length) const {
+  for (const auto& flag : flags_) {
+    if (strncmp(flag.name, name, length) == 0 && flag.name[length] == '\0') {
+      return &flag;
+    }
+  }
+  return nullptr;
+}
+
+static bool ParseBool(const char* s, bool* value) {
+  if (strcmp(s, "true") == 0 || strcmp(s, "1") == 0 || strcmp(s, "yes") == 0) {
+    *value = true;
+    return true;
+  }
+  if (strcmp(s, "false") == 0 || strcmp(s, "0") == 0 || strcmp(s, "no") == 0) {
+    *value = false;
+    return true;
+  }
+  return false;
+}
+
+bool CommandLineFlags::Assign(const Flag& flag, const char* value) {
+  bool ok = true;
+  switch (flag.type) {
+    case BOOL:
+      ok = ParseBool(value, static_cast<bool*>(flag.value));
+      break;
+    case INT:
+      ok = absl::SimpleAtoi(value, static_cast<int*>(flag.value));
+      break;
+    case STRING:
+      static_cast<string*>(flag.value)->assign(value);
+      break;
+  }
+  if (!ok) {
+    errors_.push_back(
+        absl::StrCat("invalid value \"", value, "\" of flag ", flag.name));
+  }
+  return ok;
+}
+
+void CommandLineFlags::ParseEnvironment() {
+  string env_name;
+  for (const auto& flag : flags_) {
+    env_name = "XENIA_";
+    for (const char* p = flag.name; *p != '\0'; ++p) {
+      env_name.push_back(static_cast<char>(toupper(*p)));
+    }
+    const char* value = getenv(env_name.c_str());
+    if (value != nullptr) { Assign(flag, value); }
+  }
+}
+
+bool CommandLineFlags::Parse(int* argc, char*** argv, bool remove_flags) {
+  errors_.clear();
+  ParseEnvironment();
+  // The arguments which are not flags move to the front when flags are
+  // removed, and argv stays untouched otherwise.
+  char** args = *argv;
+  int kept = 1;
+  auto keep = [&](char* arg) {
+    if (remove_flags) { args[kept++] = arg; }
+  };
+  int i = 1;
+  for (; i < *argc; ++i) {
+    char* arg = args[i];
+    if (arg[0] != '-' || arg[1] == '\0') {
+      keep(arg);
+      continue;
+    }
+    if (strcmp(arg, "--") == 0) {
+      ++i;
+      break;
+    }
+    const char* name = arg + (arg[1] == '-' ? 2 : 1);
+    const char* value = strchr(name, '=');
+    size_t length = value != nullptr ? value - name : strlen(name);
+    if (value != nullptr) { ++value; }
+    const Flag* flag = Find(name, length);
+    if (flag == nullptr && value == nullptr && strncmp(name, "no", 2) == 0) {
+      flag = Find(name + 2, length - 2);
+      if (flag != nullptr && flag->type != BOOL) { flag = nullptr; }
+      if (flag != nullptr) { value = "false"; }
+    }
+    if (flag == nullptr) {
+      keep(arg);
+      continue;
+    }
+    if (value == nullptr) {
+      if (flag->type == BOOL) {
+        value = "true";
+      } else if (i + 1 < *argc) {
+        value = args[++i];
+      } else {
+        errors_.push_back(string("missing value of flag ") + flag->name);
+        continue;
+      }
+    }
+    Assign(*flag, value);
+  }
+  for (; i < *argc; ++i) { keep(args[i]); }
+  if (remove_flags) {
+    *argc = kept;
+    args[kept] = nullptr;
+  }
+  return errors_.empty();
+}
+
+}  // namespace base
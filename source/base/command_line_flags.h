@@ -0,0 +1,45 @@
+#ifndef BASE_COMMAND_LINE_FLAGS_H_
+#define BASE_COMMAND_LINE_FLAGS_H_
+
+#include "base/using_std.h"
+
+namespace base {
+
+// A small parser of command line flags, which stores their values straight
+// into the registered variables. It accepts
+//   --name=value, --name value, and --name or --noname for booleans.
+// A single leading dash works as well, and "--" ends the flags. A flag which
+// is missing from the command line falls back to the environment variable
+// XENIA_<NAME>, e.g. XENIA_LOG_DIR for --log_dir. Unknown flags are left alone.
+class CommandLineFlags {
+ public:
+  CommandLineFlags() { }
+  void AddBool(const char* name, bool* value);
+  void AddInt(const char* name, int* value);
+  void AddString(const char* name, string* value);
+
+  // Parses the environment and then argv. The recognized flags are removed
+  // from argv when remove_flags is set. Returns false if some value is
+  // malformed, see errors().
+  bool Parse(int* argc, char*** argv, bool remove_flags);
+  const std::vector<string>& errors() const { return errors_; }
+
+ private:
+  enum Type { BOOL, INT, STRING };
+  struct Flag {
+    const char* name;
+    Type type;
+    void* value;
+  };
+
+  const Flag* Find(const char* name, size_t length) const;
+  bool Assign(const Flag& flag, const char* value);
+  void ParseEnvironment();
+
+  std::vector<Flag> flags_;
+  std::vector<string> errors_;
+};
+
+}  // namespace base
+
+#endif  // BASE_COMMAND_LINE_FLAGS_H_
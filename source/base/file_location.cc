@@ -1,12 +1,15 @@
 #include "base/file_location.h"
 
+#include "absl/str_cat.h"
+#include "base/string_pool.h"
+
 namespace base {
 
+FileLocation::FileLocation(absl::string_view file, int line)
+    : file_(StringPool::Default()->Intern(file)), line_(line) { }
+
 string FileLocation::ToString() const {
-  char buf[16];
-  memset(buf, 0, sizeof(buf));
-  snprintf(buf, sizeof(buf), ":%d", line_);
-  return file_ + buf;
+  return absl::StrCat(file_, ":", line_);
 }
 
 }  // namespace base
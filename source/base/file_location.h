@@ -1,18 +1,21 @@
 #ifndef BASE_FILE_LOCATION_H_
 #define BASE_FILE_LOCATION_H_
 
+#include "absl/string_view.h"
 #include "base/using_std.h"
 
 namespace base {
 
 class FileLocation {
  public:
-  FileLocation(string file, int line) : file_(std::move(file)), line_(line) { }
-  const char* file() const { return file_.c_str(); }
+  // The file name is interned in the default StringPool, so locations copy
+  // no strings.
+  FileLocation(absl::string_view file, int line);
+  const char* file() const { return file_.data(); }
   int line() const { return line_; }
   string ToString() const;
  private:
-  const string file_;
+  const absl::string_view file_;
   int line_;
 };
 
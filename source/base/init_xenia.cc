@@ -1,11 +1,59 @@
 #include "base/init_xenia.h"
 
+#include "base/alloc_tracker.h"
+#include "base/command_line_flags.h"
 #include "base/logging.h"
 
 namespace base {
 
-void InitXenia(const char* app_name, int* argc, char*** argv, bool remove_flag) {
-  ::base::logging::SetLogOutputDevice(
-      new ::base::logging::LogOutputFileDevice(app_name));
+namespace {
+// The flags which tune the logging subsystem.
+struct LoggingFlags {
+  int v = 0;
+  string vmodule;
+  string log_dir = "/tmp/";
+  bool log_async = false;
+  int log_buffer_bytes = 0;
+  int log_flush_ms = -1;
+  // The interval of allocation stats in the log, 0 for none, logged by
+  // MaybeLogAllocStats. The stats are only collected in builds with
+  // XENIA_ALLOC_TRACKING.
+  int alloc_stats_ms = 0;
+};
+}  // namespace
+
+void InitXenia(const char* app_name, int* argc, char*** argv,
+               bool remove_flags) {
+  LoggingFlags flags;
+  CommandLineFlags parser;
+  parser.AddInt("v", &flags.v);
+  parser.AddString("vmodule", &flags.vmodule);
+  parser.AddString("log_dir", &flags.log_dir);
+  parser.AddBool("log_async", &flags.log_async);
+  parser.AddInt("log_buffer_bytes", &flags.log_buffer_bytes);
+  parser.AddInt("log_flush_ms", &flags.log_flush_ms);
+  parser.AddInt("alloc_stats_ms", &flags.alloc_stats_ms);
+  if (argc != nullptr && argv != nullptr) {
+    parser.Parse(argc, argv, remove_flags);
+  }
+
+  ::base::logging::LogFileOptions options;
+  options.dir = flags.log_dir;
+  options.buffer_bytes = std::max(flags.log_buffer_bytes, 0);
+  options.flush_ms = flags.log_flush_ms;
+  ::base::logging::LogOutputDevice* device =
+      new ::base::logging::LogOutputFileDevice(app_name, std::move(options));
+  if (flags.log_async) {
+    auto* tee = new ::base::logging::LogOutputTeeDevice();
+    tee->AddSink(device);
+    device = tee;
+  }
+  ::base::logging::SetLogOutputDevice(device);
+  ::base::logging::SetVLogLevel(flags.v);
+
+  for (const auto& error : parser.errors()) { LOG(ERROR) << error; }
+  ::base::logging::RegisterVLogModules(flags.vmodule);
+  SetAllocStatsInterval(flags.alloc_stats_ms);
 }
+
 }  // namespace base
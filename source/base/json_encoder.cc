@@ -0,0 +1,115 @@
+#include "base/json_encoder.h"
+
+#include <charconv>
+#include <cmath>
+
+#include "absl/utf8.h"
+
+namespace base {
+
+namespace {
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighs = 0x8080808080808080ULL;
+
+// Returns a mask with the high bit set in the lowest byte of word which
+// needs escaping. Higher bytes may be flagged falsely, the lowest may not.
+inline uint64_t EscapeMask(uint64_t word) {
+  uint64_t quote = word ^ (kOnes * '"');
+  uint64_t slash = word ^ (kOnes * '\\');
+  uint64_t control = (word - kOnes * 0x20) & ~word;
+  quote = (quote - kOnes) & ~quote;
+  slash = (slash - kOnes) & ~slash;
+  return (control | quote | slash) & kHighs;
+}
+
+inline bool NeedsEscape(unsigned char c) {
+  return c < 0x20 || c == '"' || c == '\\';
+}
+
+// Returns the offset of the first byte in [p, p + n) which needs escaping.
+size_t SafePrefixLength(const char* p, size_t n) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, p + i, sizeof(word));
+    uint64_t mask = EscapeMask(word);
+    if (mask != 0) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      return i + (__builtin_ctzll(mask) >> 3);
+#else
+      break;
+#endif
+    }
+  }
+  while (i < n && !NeedsEscape(static_cast<unsigned char>(p[i]))) { ++i; }
+  return i;
+}
+
+void AppendEscaped(unsigned char c, string* out) {
+  static const char kHex[] = "0123456789abcdef";
+  switch (c) {
+    case '"': out->append("\\\""); return;
+    case '\\': out->append("\\\\"); return;
+    case '\b': out->append("\\b"); return;
+    case '\f': out->append("\\f"); return;
+    case '\n': out->append("\\n"); return;
+    case '\r': out->append("\\r"); return;
+    case '\t': out->append("\\t"); return;
+  }
+  char buf[6] = { '\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xf] };
+  out->append(buf, sizeof(buf));
+}
+}  // namespace
+
+void AppendJsonString(absl::string_view s, string* out) {
+  if (!absl::IsValidUtf8(s)) {
+    AppendJsonString(absl::ToValidUtf8(s), out);
+    return;
+  }
+  out->push_back('"');
+  const char* p = s.data();
+  size_t n = s.size();
+  while (n > 0) {
+    size_t safe = SafePrefixLength(p, n);
+    out->append(p, safe);
+    if (safe == n) { break; }
+    AppendEscaped(static_cast<unsigned char>(p[safe]), out);
+    p += safe + 1;
+    n -= safe + 1;
+  }
+  out->push_back('"');
+}
+
+void AppendJsonUint(uint64_t value, string* out) {
+  char buf[24];
+  char* end = buf + sizeof(buf);
+  char* p = end;
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  out->append(p, end - p);
+}
+
+void AppendJsonInt(int64_t value, string* out) {
+  uint64_t magnitude = static_cast<uint64_t>(value);
+  if (value < 0) {
+    out->push_back('-');
+    magnitude = 0 - magnitude;
+  }
+  AppendJsonUint(magnitude, out);
+}
+
+void AppendJsonDouble(double value, string* out) {
+  if (!std::isfinite(value)) {
+    out->append("null");
+    return;
+  }
+  // The shortest form which reads back as the same value, in one pass and
+  // whatever the locale.
+  char buf[32];
+  auto result = std::to_chars(buf, buf + sizeof(buf), value);
+  out->append(buf, result.ptr - buf);
+}
+
+}  // namespace base
@@ -0,0 +1,62 @@
+#ifndef BASE_JSON_ENCODER_H_
+#define BASE_JSON_ENCODER_H_
+
+#include <cstdint>
+
+#include "absl/string_view.h"
+#include "base/using_std.h"
+
+namespace base {
+
+// Appends the JSON encoding of a value to the end of out. Nothing but out is
+// allocated, so callers which reserve out up front encode without allocation.
+// Strings which are not valid UTF-8 get U+FFFD for each bad byte, so the
+// output stays valid JSON; only these are copied first.
+void AppendJsonString(absl::string_view s, string* out);
+void AppendJsonInt(int64_t value, string* out);
+void AppendJsonUint(uint64_t value, string* out);
+// Non-finite values have no JSON representation and are written as null.
+void AppendJsonDouble(double value, string* out);
+
+inline void AppendJsonValue(bool value, string* out) {
+  out->append(value ? "true" : "false");
+}
+inline void AppendJsonValue(absl::string_view value, string* out) {
+  AppendJsonString(value, out);
+}
+inline void AppendJsonValue(const char* value, string* out) {
+  if (value == nullptr) {
+    out->append("null");
+  } else {
+    AppendJsonString(value, out);
+  }
+}
+inline void AppendJsonValue(const string& value, string* out) {
+  AppendJsonString(value, out);
+}
+inline void AppendJsonValue(std::nullptr_t, string* out) {
+  out->append("null");
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value &&
+                        std::is_signed<T>::value>::type
+AppendJsonValue(T value, string* out) {
+  AppendJsonInt(value, out);
+}
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value &&
+                        std::is_unsigned<T>::value &&
+                        !std::is_same<T, bool>::value>::type
+AppendJsonValue(T value, string* out) {
+  AppendJsonUint(value, out);
+}
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+AppendJsonValue(T value, string* out) {
+  AppendJsonDouble(value, out);
+}
+
+}  // namespace base
+
+#endif  // BASE_JSON_ENCODER_H_
@@ -1,5 +1,12 @@
 #include "base/logging.h"
 
+#include "absl/flat_hash_map.h"
+#include "absl/glob.h"
+#include "absl/numbers.h"
+#include "absl/str_cat.h"
+#include "absl/str_split.h"
+#include "base/alloc_tracker.h"
+
 namespace base {
 namespace logging {
 namespace {
@@ -8,17 +15,31 @@ class LogVerboseGroup {
   LogVerboseGroup() { }
   void SetVerboseLevel(int level) { verbose_level_ = level; }
   void Register(int level, const string& module) {
-    modules_[module] = level;
+    if (module.find_first_of("*?[") == string::npos) {
+      modules_[module] = level;
+    } else {
+      patterns_.Add(module);
+      pattern_levels_.push_back(level);
+    }
   }
-  bool ShouldLog(int level, const string& module) const {
+  bool ShouldLog(int level, absl::string_view module) const {
     if (level <= 0) { return true; }
     auto it = modules_.find(module);
-    if (it == modules_.end()) return level <= verbose_level_;
-    return level <= it->second;
+    if (it != modules_.end()) { return level <= it->second; }
+    // Of the patterns, the first registered which matches wins.
+    if (!pattern_levels_.empty()) {
+      size_t pattern = patterns_.Match(module);
+      if (pattern != absl::GlobSet::npos) {
+        return level <= pattern_levels_[pattern];
+      }
+    }
+    return level <= verbose_level_;
   }
  private:
   int verbose_level_ = 0;
-  std::map<string, int> modules_;
+  absl::flat_hash_map<string, int> modules_;
+  absl::GlobSet patterns_;
+  std::vector<int> pattern_levels_;
 };
 static std::unique_ptr<LogVerboseGroup> kLogVerboseGroup;
 }  // namespace
@@ -51,6 +72,20 @@ void RegisterVLogModule(int level, const string& module) {
   GetLogVerboseGroup()->Register(level, module);
 }
 
+void RegisterVLogModules(const string& vmodule) {
+  for (absl::string_view item :
+       absl::StrSplit(vmodule, ',', absl::SkipEmpty())) {
+    size_t eq = item.rfind('=');
+    int level = 0;
+    if (eq == absl::string_view::npos || eq == 0 ||
+        !absl::SimpleAtoi(item.substr(eq + 1), &level)) {
+      LOG(ERROR) << "Invalid --vmodule item: " << item;
+      continue;
+    }
+    RegisterVLogModule(level, string(item.substr(0, eq)));
+  }
+}
+
 static const char* LogFileNameSuffix(Severity severity) {
   if (severity == INFO) { return ".LOG.INFO"; }
   if (severity == WARNING) { return ".LOG.WARNING"; }
@@ -61,20 +96,39 @@ static const char* LogFileNameSuffix(Severity severity) {
 
 void LogOutputFileDevice::Send(Severity severity, const string& data) {
   if (data.empty()) { return; }
-  if (outputs_[severity] == nullptr) {
-    string file_name("/tmp/");
+  auto& output = outputs_[severity];
+  if (output.stream == nullptr) {
+    string file_name(options_.dir);
+    if (file_name.empty() || file_name.back() != '/') { file_name += '/'; }
     file_name += app_name_;
     file_name += LogFileNameSuffix(severity);
-    outputs_[severity].reset(new std::ofstream(file_name));
+    output.stream.reset(new std::ofstream());
+    if (options_.buffer_bytes > 0) {
+      // The buffer has to be installed before the file is opened.
+      output.buffer.reset(new char[options_.buffer_bytes]);
+      output.stream->rdbuf()->pubsetbuf(output.buffer.get(),
+                                        options_.buffer_bytes);
+    }
+    output.stream->open(file_name);
+    output.last_flush = std::chrono::steady_clock::now();
+  }
+  output.stream->write(data.c_str(), data.size());
+  if (options_.flush_ms >= 0) {
+    auto now = std::chrono::steady_clock::now();
+    if (now - output.last_flush >=
+        std::chrono::milliseconds(options_.flush_ms)) {
+      output.stream->flush();
+      output.last_flush = now;
+    }
   }
-  outputs_[severity]->write(data.c_str(), data.size());
 }
 
 void LogOutputFileDevice::Reset() {
-  outputs_[INFO].reset(nullptr);
-  outputs_[WARNING].reset(nullptr);
-  outputs_[ERROR].reset(nullptr);
-  outputs_[FATAL].reset(nullptr);
+  // The streams go before the buffers they write into.
+  for (auto& output : outputs_) {
+    output.second.stream.reset(nullptr);
+    output.second.buffer.reset(nullptr);
+  }
 }
 
 void LogOutputStringDevice::Send(Severity severity, const string& data) {
@@ -85,14 +139,140 @@ void LogOutputStringDevice::Reset() {
   if (output_ != nullptr) { output_->clear(); }
 }
 
-static string GetBaseName(const char* file) {
-  if (file == nullptr) { return ""; }
-  string str(file);
-  auto pos = str.rfind('/');
-  return pos == string::npos ? str : str.substr(pos + 1);
+class LogOutputTeeDevice::Sink {
+ public:
+  Sink(LogOutputDevice* device, Severity min_severity, size_t max_buffered)
+      : device_(device), min_severity_(min_severity),
+        max_buffered_(max_buffered), worker_(&Sink::Run, this) { }
+  ~Sink() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    ready_.notify_one();
+    worker_.join();
+  }
+  bool Accepts(Severity severity) const { return severity >= min_severity_; }
+  LogFormat format() const { return device_->format(); }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  void Push(Severity severity, const string& msg) {
+    bool was_empty;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.size() >= max_buffered_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      was_empty = queue_.empty();
+      queue_.emplace_back(severity, msg);
+    }
+    // The worker only sleeps on an empty queue.
+    if (was_empty) { ready_.notify_one(); }
+  }
+
+  // Waits until the buffer has drained, for at most the timeout.
+  bool Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return WaitDrained(&lock);
+  }
+
+  // Resets the device once the buffer has drained. A sink which does not
+  // drain within the timeout is left alone, its worker still owns the device.
+  void Reset() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (WaitDrained(&lock)) { device_->Reset(); }
+  }
+
+ private:
+  static constexpr std::chrono::milliseconds kFlushTimeout{2000};
+
+  bool WaitDrained(std::unique_lock<std::mutex>* lock) {
+    return drained_.wait_for(*lock, kFlushTimeout, [this] {
+      return queue_.empty() && !writing_;
+    });
+  }
+
+  void Run() {
+    std::deque<std::pair<Severity, string>> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) { break; }
+      batch.swap(queue_);
+      writing_ = true;
+      lock.unlock();
+      for (const auto& msg : batch) { device_->Send(msg.first, msg.second); }
+      batch.clear();
+      lock.lock();
+      writing_ = false;
+      drained_.notify_all();
+    }
+  }
+
+  const std::unique_ptr<LogOutputDevice> device_;
+  const Severity min_severity_;
+  const size_t max_buffered_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::condition_variable drained_;
+  std::deque<std::pair<Severity, string>> queue_;
+  bool writing_ = false;
+  bool stopping_ = false;
+  std::atomic<uint64_t> dropped_{0};
+  std::thread worker_;
+};
+
+LogOutputTeeDevice::LogOutputTeeDevice() { }
+
+LogOutputTeeDevice::~LogOutputTeeDevice() { }
+
+size_t LogOutputTeeDevice::AddSink(LogOutputDevice* device,
+                                   Severity min_severity,
+                                   size_t max_buffered) {
+  sinks_.emplace_back(new Sink(device, min_severity, max_buffered));
+  return sinks_.size() - 1;
+}
+
+void LogOutputTeeDevice::Send(Severity severity, const string& msg) {
+  for (auto& sink : sinks_) {
+    if (sink->Accepts(severity)) { sink->Push(severity, msg); }
+  }
+}
+
+void LogOutputTeeDevice::SendRecord(Severity severity,
+                                    const LogRecord& record) {
+  for (auto& sink : sinks_) {
+    if (sink->Accepts(severity)) {
+      sink->Push(severity, record.Format(sink->format()));
+    }
+  }
+}
+
+bool LogOutputTeeDevice::Flush() {
+  bool drained = true;
+  for (auto& sink : sinks_) { drained = sink->Flush() && drained; }
+  return drained;
+}
+
+void LogOutputTeeDevice::Reset() {
+  for (auto& sink : sinks_) { sink->Reset(); }
+}
+
+uint64_t LogOutputTeeDevice::dropped(size_t sink) const {
+  return sinks_[sink]->dropped();
+}
+
+// The base name is a view into file, which is usually __FILE__.
+static absl::string_view GetBaseName(const char* file) {
+  if (file == nullptr) { return absl::string_view(); }
+  absl::string_view path(file);
+  auto pos = path.rfind('/');
+  return pos == absl::string_view::npos ? path : path.substr(pos + 1);
 }
 
 static string GetTidStr() {
+  ALLOC_SCOPE("logging");
   // TODO: get thread id.
   return "tid";
 }
@@ -110,39 +290,94 @@ static const char* GetSeverityTag(Severity severity) {
   return "U";
 }
 
+static const char* GetSeverityName(Severity severity) {
+  if (severity == INFO) { return "INFO"; }
+  if (severity == WARNING) { return "WARNING"; }
+  if (severity == ERROR) { return "ERROR"; }
+  if (severity == FATAL) { return "FATAL"; }
+  return "UNKNOWN";
+}
+
+const string& LogRecord::Format(LogFormat format) const {
+  if (format == JSON) {
+    if (json_.empty()) { FormatJson(&json_); }
+    return json_;
+  }
+  if (text_.empty()) { FormatText(&text_); }
+  return text_;
+}
+
+void LogRecord::FormatText(string* out) const {
+  // The optional parts are empty pieces, so the line is built at its exact
+  // size in one go.
+  absl::string_view error_separator;
+  absl::string_view error;
+  if (perror_ != 0) {
+    error_separator = ": ";
+    error = strerror(perror_);
+  }
+  absl::string_view fields_begin;
+  absl::string_view fields;
+  absl::string_view fields_end;
+  if (!fields_.empty()) {
+    fields_begin = " {";
+    fields = absl::string_view(fields_).substr(1);
+    fields_end = "}";
+  }
+  if (print_prefix_) {
+    absl::StrAppend(out, GetSeverityTag(severity_), "<Time> ", tid_, " ",
+                    location_.file(), ":", location_.line(), " ", message_,
+                    error_separator, error, fields_begin, fields, fields_end,
+                    "\n");
+  } else {
+    absl::StrAppend(out, message_, error_separator, error, fields_begin,
+                    fields, fields_end, "\n");
+  }
+}
+
+void LogRecord::FormatJson(string* out) const {
+  out->reserve(64 + message_.size() + fields_.size());
+  *out += "{\"severity\":\"";
+  *out += GetSeverityName(severity_);
+  *out += "\",\"tid\":";
+  AppendJsonString(tid_, out);
+  *out += ",\"file\":";
+  AppendJsonString(location_.file(), out);
+  *out += ",\"line\":";
+  AppendJsonInt(location_.line(), out);
+  *out += ",\"msg\":";
+  AppendJsonString(message_, out);
+  if (perror_ != 0) {
+    *out += ",\"errno\":";
+    AppendJsonInt(perror_, out);
+    *out += ",\"error\":";
+    AppendJsonString(strerror(perror_), out);
+  }
+  *out += fields_;
+  *out += "}\n";
+}
+
 LogMessage::~LogMessage() {
-  if (stream_.str().empty()) { return; }
+  ALLOC_SCOPE("logging");
+  string message = stream_.str();
+  if (message.empty() && fields_.empty()) { return; }
   if (!GetLogVerboseGroup()->ShouldLog(verbose_level_, location_.file())) {
     return;
   }
   auto* device = GetLogOutputDevice();
-  string str;
-  if (print_prefix_) {
-    str += GetSeverityTag(severity_);
-    str += "<Time>";
-    str += " ";
-    str += tid_str_;
-    str += " ";
-    str += location_.ToString();
-    str += " ";
-  }
-  str += stream_.str();
-  if (perror_ != 0) {
-    str += ": ";
-    str += strerror(perror_);
-  }
-  str += "\n";
-  if (output_string_ != nullptr) { *output_string_ = str; }
-  device->Send(severity_, str);
+  LogRecord record(severity_, location_, tid_str_, print_prefix_, message,
+                   perror_, fields_);
+  if (output_string_ != nullptr) { *output_string_ = record.Format(TEXT); }
+  device->SendRecord(severity_, record);
   if (severity_ == FATAL) {
-    device->Send(INFO, str);
-    device->Send(WARNING, str);
-    device->Send(ERROR, str);
+    device->SendRecord(INFO, record);
+    device->SendRecord(WARNING, record);
+    device->SendRecord(ERROR, record);
   } else if (severity_ == ERROR) {
-    device->Send(INFO, str);
-    device->Send(WARNING, str);
+    device->SendRecord(INFO, record);
+    device->SendRecord(WARNING, record);
   } else if (severity_ == WARNING) {
-    device->Send(INFO, str);
+    device->SendRecord(INFO, record);
   }
   if (severity_ == FATAL) {
     device->Reset();
@@ -152,9 +387,13 @@ LogMessage::~LogMessage() {
 
 LogMessage& LogMessage::SetPerror() {
   perror_ = errno;
+  return *this;
 }
 
 ScopedLog::ScopedLog() {
+  // Creates the default device if there is none, so that Release() has a
+  // device to put back in place of the one which writes into log_.
+  GetLogOutputDevice();
   device_ = std::move(kLogOutputDevice);
   kLogOutputDevice.reset(new LogOutputStringDevice(&log_));
 }
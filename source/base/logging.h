@@ -1,7 +1,10 @@
 #ifndef BASE_LOGGING_H_
 #define BASE_LOGGING_H_
 
+#include "absl/ascii.h"
+#include "absl/string_view.h"
 #include "base/file_location.h"
+#include "base/json_encoder.h"
 
 namespace base {
 
@@ -15,24 +18,86 @@ enum Severity {
   FATAL
 };
 
+// The format in which a device receives log messages.
+enum LogFormat {
+  TEXT,
+  JSON
+};
+
+// One log message on its way to a device. It is rendered lazily, and at most
+// once per format, into the format each device asks for.
+class LogRecord {
+ public:
+  LogRecord(Severity severity, const FileLocation& location,
+            const string& tid, bool print_prefix, const string& message,
+            int perror, const string& fields)
+      : severity_(severity), location_(location), tid_(tid),
+        print_prefix_(print_prefix), message_(message), perror_(perror),
+        fields_(fields) { }
+  Severity severity() const { return severity_; }
+  const string& Format(LogFormat format) const;
+ private:
+  void FormatText(string* out) const;
+  void FormatJson(string* out) const;
+
+  const Severity severity_;
+  const FileLocation& location_;
+  const string& tid_;
+  const bool print_prefix_;
+  const string& message_;
+  const int perror_;
+  // The structured fields as JSON members, each preceded by a comma.
+  const string& fields_;
+  mutable string text_;
+  mutable string json_;
+};
+
 // The abstract device of log output.
 class LogOutputDevice {
  public:
   virtual ~LogOutputDevice() { }
   virtual void Send(Severity severity, const string& msg) = 0;
   virtual void Reset() = 0;
+  // Sends the record rendered in the format of this device.
+  virtual void SendRecord(Severity severity, const LogRecord& record) {
+    Send(severity, record.Format(format_));
+  }
+  LogFormat format() const { return format_; }
+  void SetFormat(LogFormat format) { format_ = format; }
+ private:
+  LogFormat format_ = TEXT;
+};
+
+// The options of LogOutputFileDevice.
+struct LogFileOptions {
+  // The directory of the log files.
+  string dir = "/tmp/";
+  // The size of the stream buffer of each file, 0 for the default size.
+  size_t buffer_bytes = 0;
+  // The least interval between two flushes of a file in milliseconds. A file
+  // is flushed after every message with 0, and only when its buffer is full
+  // with a negative interval.
+  int flush_ms = -1;
 };
 
 // The device for log output into file.
 class LogOutputFileDevice : public LogOutputDevice {
  public:
-  explicit LogOutputFileDevice(string app_name)
-      : app_name_(std::move(app_name)) { }
+  explicit LogOutputFileDevice(string app_name,
+                               LogFileOptions options = LogFileOptions())
+      : app_name_(std::move(app_name)), options_(std::move(options)) { }
   void Send(Severity severity, const string& msg) override;
   void Reset() override;
  private:
+  struct Output {
+    std::unique_ptr<char[]> buffer;
+    std::unique_ptr<std::ofstream> stream;
+    std::chrono::steady_clock::time_point last_flush;
+  };
+
   const string app_name_;
-  std::map<Severity, std::unique_ptr<std::ofstream>> outputs_;
+  const LogFileOptions options_;
+  std::map<Severity, Output> outputs_;
 };
 
 // The device for log output into string
@@ -45,6 +110,33 @@ class LogOutputStringDevice : public LogOutputDevice {
   string *const output_;  
 };
 
+// The device which tees log output into several sink devices. Every sink has
+// a minimum severity, a bounded buffer and a worker thread of its own, so that
+// a slow sink drops and counts messages instead of stalling the threads which
+// log. Sinks must be added before the device is used.
+class LogOutputTeeDevice : public LogOutputDevice {
+ public:
+  static constexpr size_t kDefaultMaxBuffered = 4096;
+
+  LogOutputTeeDevice();
+  ~LogOutputTeeDevice() override;
+  // Takes the ownership of device and returns the index of the sink.
+  size_t AddSink(LogOutputDevice* device, Severity min_severity = INFO,
+                 size_t max_buffered = kDefaultMaxBuffered);
+  void Send(Severity severity, const string& msg) override;
+  void SendRecord(Severity severity, const LogRecord& record) override;
+  // Waits for the sinks to write what they have buffered. Returns false if
+  // some sink did not catch up within a bounded time.
+  bool Flush();
+  // Flushes the sinks, then resets them.
+  void Reset() override;
+  // The number of messages the sink has dropped because its buffer was full.
+  uint64_t dropped(size_t sink) const;
+ private:
+  class Sink;
+  std::vector<std::unique_ptr<Sink>> sinks_;
+};
+
 class LogOutputVoidDevice : public LogOutputDevice {
  public:
   LogOutputVoidDevice() { }
@@ -56,7 +148,14 @@ class LogOutputVoidDevice : public LogOutputDevice {
 // Set and take the ownership of device.
 void SetLogOutputDevice(LogOutputDevice* device);
 void SetVLogLevel(int level);
+// Sets the verbose level of the files whose base name, without directories,
+// is module. A module with wildcards is an absl::Glob over the base name,
+// like "net_*.cc" or "*_server.*"; an exact name takes precedence, then the
+// first pattern registered which matches.
 void RegisterVLogModule(int level, const string& module);
+// Registers the modules of a --vmodule value, "module=level,...". Malformed
+// items are logged as errors and skipped.
+void RegisterVLogModules(const string& vmodule);
 
 struct NoPrefixTag { };
 inline NoPrefixTag no_prefix() { return NoPrefixTag(); }
@@ -74,11 +173,28 @@ class LogMessage {
 
   LogMessage& SetNoPrefix() {
     print_prefix_ = false;
+    return *this;
   }
 
-  LogMessage& OutputToStringAndLog(string* msg) { output_string_ = msg; }
+  LogMessage& OutputToStringAndLog(string* msg) {
+    output_string_ = msg;
+    return *this;
+  }
   LogMessage& SetPerror();
 
+  // Attaches a structured field, e.g.
+  //   LOG(INFO).With("player_id", id).With("ms", dt) << "login";
+  // The value is JSON encoded straight into the field buffer of the message.
+  template <typename T>
+  LogMessage& With(absl::string_view key, const T& value) {
+    if (fields_.empty()) { fields_.reserve(kFieldsReserve); }
+    fields_.push_back(',');
+    AppendJsonString(key, &fields_);
+    fields_.push_back(':');
+    AppendJsonValue(value, &fields_);
+    return *this;
+  }
+
   template <typename T>
   LogMessage& operator<<(const T& val) {
     stream_ << val;
@@ -105,6 +221,9 @@ class LogMessage {
   bool print_prefix_ = true;
   int perror_ = 0;
   string* output_string_ = nullptr;
+  string fields_;
+
+  static constexpr size_t kFieldsReserve = 128;
 };
 
 class LogMessageNullify {
@@ -116,6 +235,8 @@ class LogMessageNullify {
   LogMessageNullify& OutputToStringAndLog(string*) { return *this; }
   LogMessageNullify& SetPerror() { return *this; }
   template <typename T>
+  LogMessageNullify& With(absl::string_view, const T&) { return *this; }
+  template <typename T>
   LogMessageNullify& operator<<(const T&) { return *this; }
 };
 
@@ -188,16 +309,18 @@ class ScopedLog {
 #define CHECK_NULL(a) \
     LOG_IF(FATAL, (!((a) == nullptr))) << "Check failed: " #a " is null "
 #define CHECK_STREQ(a, b) \
-    LOG_IF(FATAL, (!(strcmp((a) == (b)) == 0))) << "Check failed: " #a " (\"" << (a) \
+    LOG_IF(FATAL, (!(strcmp((a), (b)) == 0))) << "Check failed: " #a " (\"" << (a) \
         << "\") == " #b " (\"" << (b) << "\") "
 #define CHECK_STRNE(a, b) \
-    LOG_IF(FATAL, (!(strcmp((a) == (b)) != 0))) << "Check failed: " #a " (\"" << (a) \
+    LOG_IF(FATAL, (!(strcmp((a), (b)) != 0))) << "Check failed: " #a " (\"" << (a) \
         << "\") != " #b " (\"" << (b) << "\") "
 #define CHECK_STRCASEEQ(a, b) \
-    LOG_IF(FATAL, (!(strcasecmp((a) == (b)) == 0))) << "Check failed: " #a " (\"" << (a) \
+    LOG_IF(FATAL, (!absl::EqualsIgnoreCase((a), (b)))) \
+        << "Check failed: " #a " (\"" << (a) \
         << "\") == " #b " (\"" << (b) << "\") "
 #define CHECK_STRCASENE(a, b) \
-    LOG_IF(FATAL, (!(strcasecmp((a) == (b)) != 0))) << "Check failed: " #a " (\"" << (a) \
+    LOG_IF(FATAL, (absl::EqualsIgnoreCase((a), (b)))) \
+        << "Check failed: " #a " (\"" << (a) \
         << "\") != " #b " (\"" << (b) << "\") "
 #define CHECK_INDEX(I, A) CHECK(I < (sizeof(A) / sizeof(A[0])))
 #define CHECK_BOUND(B, A) CHECK(B <= (sizeof(A) / sizeof(A[0])))
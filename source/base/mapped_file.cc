@@ -0,0 +1,66 @@
+#include "base/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace base {
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (&other != this) {
+    Close();
+    data_ = other.data_;
+    size_ = other.size_;
+    open_ = other.open_;
+    error_ = std::move(other.error_);
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.open_ = false;
+  }
+  return *this;
+}
+
+bool MappedFile::Open(const string& path) {
+  Close();
+  error_.clear();
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    error_ = "Cannot open " + path + ": " + strerror(errno);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    error_ = "Cannot stat " + path + ": " + strerror(errno);
+    close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  if (size > 0) {
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      error_ = "Cannot map " + path + ": " + strerror(errno);
+      close(fd);
+      return false;
+    }
+    data_ = static_cast<const char*>(data);
+  }
+  // The mapping keeps the file.
+  close(fd);
+  size_ = size;
+  open_ = true;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+}  // namespace base
@@ -0,0 +1,46 @@
+#ifndef BASE_MAPPED_FILE_H_
+#define BASE_MAPPED_FILE_H_
+
+#include "absl/string_view.h"
+#include "base/using_std.h"
+
+namespace base {
+
+// A whole file mapped read only into memory, for data which is used in
+// place, like an absl::StringDict. The pages are read on first touch and
+// shared with other processes which map the same file.
+//
+//   base::MappedFile file;
+//   if (!file.Open("items.dict")) {
+//     LOG(ERROR) << file.error();
+//   }
+class MappedFile {
+ public:
+  MappedFile() { }
+  ~MappedFile() { Close(); }
+  MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Maps the file at path, in place of any file mapped before. Returns
+  // false, with the reason in error(), if it cannot.
+  bool Open(const string& path);
+  void Close();
+
+  // The bytes of the file, valid until it is closed. An empty file maps to
+  // an empty view.
+  absl::string_view data() const { return absl::string_view(data_, size_); }
+  bool is_open() const { return open_; }
+  const string& error() const { return error_; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool open_ = false;
+  string error_;
+};
+
+}  // namespace base
+
+#endif  // BASE_MAPPED_FILE_H_
@@ -0,0 +1,173 @@
+#include "base/string_pool.h"
+
+#include "absl/hash.h"
+#include "base/arena.h"
+
+namespace base {
+
+struct StringPool::Entry {
+  uint64_t hash;
+  uint32_t id;
+  uint32_t size;
+  // size chars and a NUL follow.
+  const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+  absl::string_view view() const { return absl::string_view(data(), size); }
+};
+
+// An open addressing table of entries with linear probing. Readers probe it
+// without a lock; the writer of the shard fills empty slots with release
+// stores, and replaces the whole table to grow it.
+struct StringPool::Table {
+  explicit Table(size_t capacity)
+      : mask(capacity - 1), slots(new std::atomic<const Entry*>[capacity]) {
+    for (size_t i = 0; i < capacity; ++i) {
+      slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  const Entry* Find(uint64_t hash, absl::string_view s) const {
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      const Entry* entry = slots[i].load(std::memory_order_acquire);
+      if (entry == nullptr) { return nullptr; }
+      if (entry->hash == hash && entry->view() == s) { return entry; }
+    }
+  }
+  void Add(const Entry* entry) {
+    size_t i = entry->hash & mask;
+    while (slots[i].load(std::memory_order_relaxed) != nullptr) {
+      i = (i + 1) & mask;
+    }
+    slots[i].store(entry, std::memory_order_release);
+  }
+
+  const size_t mask;
+  std::unique_ptr<std::atomic<const Entry*>[]> slots;
+};
+
+class StringPool::Shard {
+ public:
+  static constexpr size_t kInitialCapacity = 64;
+  static Arena::Options ArenaOptions() {
+    Arena::Options options;
+    options.chunk_size = 16 << 10;
+    return options;
+  }
+
+  Shard()
+      : table_(new Table(kInitialCapacity)), arena_(ArenaOptions()) { }
+  ~Shard() { delete table_.load(std::memory_order_relaxed); }
+
+  const Entry* Find(uint64_t hash, absl::string_view s) const {
+    return table_.load(std::memory_order_acquire)->Find(hash, s);
+  }
+
+  // Returns the entry of s, and adds it if it is missing. publish runs on a
+  // new entry before it becomes visible to lookups.
+  template <typename F>
+  const Entry* FindOrAdd(uint64_t hash, absl::string_view s, F publish) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Table* table = table_.load(std::memory_order_relaxed);
+    if (const Entry* entry = table->Find(hash, s)) { return entry; }
+    // At most half full, so probes stay short.
+    if ((count_ + 1) * 2 > table->mask + 1) { table = Grow(table); }
+    Entry* entry = new (arena_.Allocate(sizeof(Entry) + s.size() + 1,
+                                        alignof(Entry))) Entry;
+    entry->hash = hash;
+    entry->size = static_cast<uint32_t>(s.size());
+    char* data = const_cast<char*>(entry->data());
+    if (!s.empty()) { memcpy(data, s.data(), s.size()); }
+    data[s.size()] = '\0';
+    publish(entry);
+    table->Add(entry);
+    ++count_;
+    return entry;
+  }
+
+ private:
+  // Readers may still probe the old table, so it is kept until the pool
+  // goes away; the tables retired add up to less than the live one.
+  Table* Grow(Table* old_table) {
+    Table* table = new Table((old_table->mask + 1) * 2);
+    for (size_t i = 0; i <= old_table->mask; ++i) {
+      const Entry* entry = old_table->slots[i].load(std::memory_order_relaxed);
+      if (entry != nullptr) { table->Add(entry); }
+    }
+    table_.store(table, std::memory_order_release);
+    retired_.emplace_back(old_table);
+    return table;
+  }
+
+  std::mutex mutex_;
+  std::atomic<Table*> table_;
+  std::vector<std::unique_ptr<Table>> retired_;
+  size_t count_ = 0;
+  // The entries, which live as long as the pool.
+  Arena arena_;
+};
+
+StringPool::StringPool() : shards_(new Shard[1 << kShardBits]) { }
+
+StringPool::~StringPool() {
+  for (auto& segment : segments_) {
+    delete[] segment.load(std::memory_order_relaxed);
+  }
+}
+
+StringPool* StringPool::Default() {
+  static StringPool* pool = new StringPool();
+  return pool;
+}
+
+absl::string_view StringPool::Intern(absl::string_view s) {
+  return Insert(s)->view();
+}
+
+uint32_t StringPool::InternId(absl::string_view s) { return Insert(s)->id; }
+
+const StringPool::Entry* StringPool::Insert(absl::string_view s) {
+  const uint64_t hash = absl::HashOf(s);
+  // The top bits pick the shard, the low ones the slot in its table.
+  Shard& shard = shards_[hash >> (64 - kShardBits)];
+  if (const Entry* entry = shard.Find(hash, s)) { return entry; }
+  return shard.FindOrAdd(hash, s, [this](Entry* entry) {
+    entry->id = next_id_.fetch_add(1, std::memory_order_relaxed);
+    PublishId(entry);
+  });
+}
+
+// Id i is at offset i + 1024 - (1024 << k) of segment k, where k is the
+// position of the top bit of i + 1024, less 10.
+static void LocateId(uint32_t id, int first_segment_bits, int* segment,
+                     size_t* offset) {
+  uint64_t i = uint64_t{id} + (uint64_t{1} << first_segment_bits);
+  *segment = 63 - __builtin_clzll(i) - first_segment_bits;
+  *offset = i - (uint64_t{1} << (*segment + first_segment_bits));
+}
+
+void StringPool::PublishId(const Entry* entry) {
+  int k;
+  size_t offset;
+  LocateId(entry->id, kFirstSegmentBits, &k, &offset);
+  auto* segment = segments_[k].load(std::memory_order_acquire);
+  if (segment == nullptr) {
+    // Shards race to add a segment; the loser drops its own.
+    auto* fresh = new std::atomic<const Entry*>[
+        size_t{1} << (k + kFirstSegmentBits)]();
+    if (segments_[k].compare_exchange_strong(segment, fresh,
+                                             std::memory_order_acq_rel)) {
+      segment = fresh;
+    } else {
+      delete[] fresh;
+    }
+  }
+  segment[offset].store(entry, std::memory_order_release);
+}
+
+absl::string_view StringPool::Lookup(uint32_t id) const {
+  int k;
+  size_t offset;
+  LocateId(id, kFirstSegmentBits, &k, &offset);
+  return segments_[k].load(std::memory_order_acquire)[offset]
+      .load(std::memory_order_acquire)->view();
+}
+
+}  // namespace base
@@ -0,0 +1,62 @@
+#ifndef BASE_STRING_POOL_H_
+#define BASE_STRING_POOL_H_
+
+#include <cstdint>
+
+#include "absl/string_view.h"
+#include "base/using_std.h"
+
+namespace base {
+
+// A thread safe pool of interned strings. Each distinct string is stored
+// once, NUL terminated, in blocks which the pool only frees on destruction,
+// so the views it returns stay valid as long as the pool. Two strings
+// interned in the same pool are equal exactly when their views have the
+// same data().
+//
+//   absl::string_view tag = pool.Intern(player_tag);
+//   if (tag.data() == other_tag.data()) { ... }
+//
+// The pool is split into shards by hash. A lookup of a string which is in
+// the pool already takes no lock; only inserting a new string locks its
+// shard.
+class StringPool {
+ public:
+  StringPool();
+  ~StringPool();
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  // The pool shared by the whole process, which is never destroyed.
+  static StringPool* Default();
+
+  absl::string_view Intern(absl::string_view s);
+  // Interns s, and returns its id: a small integer, dense from 0.
+  uint32_t InternId(absl::string_view s);
+  // Returns the string of an id which this pool returned.
+  absl::string_view Lookup(uint32_t id) const;
+
+  // The number of distinct strings.
+  size_t size() const { return next_id_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Entry;
+  struct Table;
+  class Shard;
+
+  static constexpr int kShardBits = 4;
+  // Ids index segments of doubling sizes, from 1 << kFirstSegmentBits.
+  static constexpr int kFirstSegmentBits = 10;
+  static constexpr int kSegments = 32 - kFirstSegmentBits;
+
+  const Entry* Insert(absl::string_view s);
+  void PublishId(const Entry* entry);
+
+  std::unique_ptr<Shard[]> shards_;
+  std::atomic<uint32_t> next_id_{0};
+  std::atomic<std::atomic<const Entry*>*> segments_[kSegments] = {};
+};
+
+}  // namespace base
+
+#endif  // BASE_STRING_POOL_H_
@@ -0,0 +1,141 @@
+#include "absl/ascii.h"
+#include "gtest/gtest.h"
+
+#include <cctype>
+#include <random>
+
+
+namespace absl {
+
+using search_internal::SearchIsa;
+
+TEST(AsciiTest, Classes) {
+  for (int i = 0; i < 256; ++i) {
+    const char c = static_cast<char>(i);
+    // The C locale agrees on ASCII, and has nothing beyond it.
+    EXPECT_EQ(!!isupper(i), ascii_isupper(c)) << i;
+    EXPECT_EQ(!!islower(i), ascii_islower(c)) << i;
+    EXPECT_EQ(!!isalpha(i), ascii_isalpha(c)) << i;
+    EXPECT_EQ(!!isdigit(i), ascii_isdigit(c)) << i;
+    EXPECT_EQ(!!isspace(i), ascii_isspace(c)) << i;
+    EXPECT_EQ(static_cast<char>(tolower(i)), ascii_tolower(c)) << i;
+    EXPECT_EQ(static_cast<char>(toupper(i)), ascii_toupper(c)) << i;
+  }
+}
+
+TEST(AsciiTest, IgnoreCase) {
+  EXPECT_TRUE(EqualsIgnoreCase("Content-Length", "content-LENGTH"));
+  EXPECT_TRUE(EqualsIgnoreCase("", ""));
+  EXPECT_FALSE(EqualsIgnoreCase("abc", "abd"));
+  EXPECT_FALSE(EqualsIgnoreCase("abc", "ab"));
+  // Only the letters have a case: @ and ` are 0x20 away from A and a.
+  EXPECT_FALSE(EqualsIgnoreCase("@", "`"));
+  EXPECT_FALSE(EqualsIgnoreCase("[", "{"));
+  EXPECT_FALSE(EqualsIgnoreCase("\xc9", "\xe9"));
+  EXPECT_TRUE(StartsWithIgnoreCase("HTTP/1.1", "http/"));
+  EXPECT_FALSE(StartsWithIgnoreCase("HTTP", "https"));
+  EXPECT_TRUE(EndsWithIgnoreCase("image.PNG", ".png"));
+  EXPECT_FALSE(EndsWithIgnoreCase("png", ".png"));
+  EXPECT_EQ(0u, FindIgnoreCase("abc", ""));
+  EXPECT_EQ(4u, FindIgnoreCase("The Quick Brown Fox", "QUICK"));
+  EXPECT_EQ(string_view::npos, FindIgnoreCase("quick", "quicker"));
+  EXPECT_TRUE(StrContainsIgnoreCase("Accept-Encoding: GZIP", "gzip"));
+  EXPECT_FALSE(StrContainsIgnoreCase("Accept-Encoding: br", "gzip"));
+}
+
+TEST(AsciiTest, Convert) {
+  string s = "Hello, World! \xc3\x89t\xc3\xa9 [@`{]";
+  AsciiStrToLower(&s);
+  EXPECT_EQ("hello, world! \xc3\x89t\xc3\xa9 [@`{]", s);
+  AsciiStrToUpper(&s);
+  EXPECT_EQ("HELLO, WORLD! \xc3\x89T\xc3\xa9 [@`{]", s);
+  string empty;
+  AsciiStrToLower(&empty);
+  EXPECT_EQ("", empty);
+}
+
+TEST(AsciiTest, Strip) {
+  EXPECT_EQ("a b", StripAsciiWhitespace(" \t\r\na b\v\f "));
+  EXPECT_EQ("a b \n", StripLeadingAsciiWhitespace("\t a b \n"));
+  EXPECT_EQ("\t a b", StripTrailingAsciiWhitespace("\t a b \n"));
+  EXPECT_EQ("", StripAsciiWhitespace(" \t\n "));
+  EXPECT_EQ("", StripAsciiWhitespace(""));
+  EXPECT_EQ("x", StripAsciiWhitespace("x"));
+  // The views are into the input.
+  string_view s = "  abc  ";
+  EXPECT_EQ(s.data() + 2, StripAsciiWhitespace(s).data());
+}
+
+class AsciiKernelsTest : public testing::TestWithParam<SearchIsa> {
+ protected:
+  void SetUp() override {
+    kernels_ = ascii_internal::GetAsciiKernels(GetParam());
+    if (kernels_ == nullptr) { GTEST_SKIP() << "Unsupported by the CPU"; }
+  }
+  const ascii_internal::AsciiKernels* kernels_ = nullptr;
+};
+
+static string RandomText(std::mt19937* rng, size_t n) {
+  // Mostly letters of both cases, with the bytes around them.
+  static const char kBytes[] = "aAbBzZ@[`{\x80\xc1\xe1 ";
+  string s;
+  for (size_t i = 0; i < n; ++i) {
+    s.push_back(kBytes[(*rng)() % (sizeof(kBytes) - 1)]);
+  }
+  return s;
+}
+
+TEST_P(AsciiKernelsTest, MatchesBytewise) {
+  std::mt19937 rng(48);
+  for (int round = 0; round < 2000; ++round) {
+    const size_t n = rng() % 100;
+    string s = RandomText(&rng, n);
+    string lower = s;
+    string upper = s;
+    kernels_->to_lower(&lower[0], n);
+    kernels_->to_upper(&upper[0], n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(ascii_tolower(s[i]), lower[i]) << s;
+      ASSERT_EQ(ascii_toupper(s[i]), upper[i]) << s;
+    }
+    EXPECT_TRUE(kernels_->equals_ignore_case(upper.data(), lower.data(), n));
+    if (n > 0) {
+      string other = s;
+      const size_t i = rng() % n;
+      other[i] = ascii_islower(other[i]) ? '@' : 'q';
+      EXPECT_FALSE(kernels_->equals_ignore_case(s.data(), other.data(), n))
+          << s << " " << other;
+    }
+  }
+}
+
+TEST_P(AsciiKernelsTest, Find) {
+  std::mt19937 rng(49);
+  for (int round = 0; round < 5000; ++round) {
+    string haystack = RandomText(&rng, rng() % 120);
+    string needle = RandomText(&rng, 1 + rng() % 4);
+    if (needle.size() > haystack.size()) { continue; }
+    string lower_haystack = haystack;
+    string lower_needle = needle;
+    for (char& c : lower_haystack) { c = ascii_tolower(c); }
+    for (char& c : lower_needle) { c = ascii_tolower(c); }
+    EXPECT_EQ(lower_haystack.find(lower_needle),
+              kernels_->find_ignore_case(haystack.data(), haystack.size(),
+                                         needle.data(), needle.size()))
+        << haystack << " " << needle;
+  }
+  string haystack(200, 'a');
+  haystack += "NeedleX";
+  EXPECT_EQ(200u, kernels_->find_ignore_case(haystack.data(),
+                                             haystack.size(), "nEEDLEx", 7));
+  EXPECT_EQ(string_view::npos,
+            kernels_->find_ignore_case(haystack.data(), haystack.size(),
+                                       "needley", 7));
+}
+
+// There is no AVX-512 kernel; AVX2 runs at memory bandwidth already.
+INSTANTIATE_TEST_SUITE_P(
+    Isa, AsciiKernelsTest,
+    testing::Values(SearchIsa::kScalar, SearchIsa::kSsse3, SearchIsa::kAvx2));
+
+}  // namespace absl
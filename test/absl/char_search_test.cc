@@ -0,0 +1,111 @@
+#include "absl/char_search.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+
+namespace absl {
+namespace search_internal {
+
+static string_view::size_type npos = string_view::npos;
+
+// The reference results, computed byte by byte.
+static size_t RefFirstOf(string_view s, string_view set, bool negate) {
+  for (size_t i = 0; i < s.size(); ++i) {
+    if ((set.find(s[i]) != npos) != negate) { return i; }
+  }
+  return npos;
+}
+
+static size_t RefLastOf(string_view s, string_view set, bool negate) {
+  for (size_t i = s.size(); i-- > 0;) {
+    if ((set.find(s[i]) != npos) != negate) { return i; }
+  }
+  return npos;
+}
+
+static size_t RefFind(string_view s, string_view needle) {
+  return string(s.data(), s.size()).find(string(needle.data(), needle.size()));
+}
+
+class CharSearchTest : public testing::TestWithParam<SearchIsa> {
+ protected:
+  void SetUp() override {
+    kernels_ = GetSearchKernels(GetParam());
+    if (kernels_ == nullptr) { GTEST_SKIP() << "Unsupported by the CPU"; }
+  }
+  const SearchKernels* kernels_ = nullptr;
+};
+
+TEST_P(CharSearchTest, CharSet) {
+  string all;
+  for (int c = 0; c < 256; ++c) { all.push_back(static_cast<char>(c)); }
+  const string sets[] = {
+    "ab", " \t\r\n", string("\x00\x80\xff", 3), "0123456789abcdefABCDEF",
+    all.substr(0x70, 0x20), all,
+  };
+  for (const auto& set : sets) {
+    CharSet chars(set);
+    for (size_t offset = 0; offset < all.size(); offset += 7) {
+      string_view s(all.data() + offset, all.size() - offset);
+      for (bool negate : { false, true }) {
+        EXPECT_EQ(RefFirstOf(s, set, negate),
+                  kernels_->find_first_of(s.data(), s.size(), chars, negate));
+        EXPECT_EQ(RefLastOf(s, set, negate),
+                  kernels_->find_last_of(s.data(), s.size(), chars, negate));
+      }
+    }
+  }
+}
+
+TEST_P(CharSearchTest, Bytes) {
+  std::mt19937 rng(7);
+  for (size_t n = 0; n < 300; n += 1 + n / 8) {
+    for (int round = 0; round < 20; ++round) {
+      // Mostly one byte, so that the searches for other bytes run long.
+      string s(n, 'a');
+      for (size_t i = 0; i < n; ++i) {
+        if (rng() % 40 == 0) { s[i] = static_cast<char>('a' + rng() % 3); }
+      }
+      for (char c : { 'a', 'b', 'c' }) {
+        CharSet chars(string(1, c));
+        EXPECT_EQ(RefLastOf(s, string(1, c), false),
+                  kernels_->find_last_byte(s.data(), n, c));
+        EXPECT_EQ(RefFirstOf(s, string(1, c), true),
+                  kernels_->find_first_not_byte(s.data(), n, c));
+        EXPECT_EQ(RefLastOf(s, string(1, c), true),
+                  kernels_->find_last_not_byte(s.data(), n, c));
+      }
+    }
+  }
+}
+
+TEST_P(CharSearchTest, Substring) {
+  std::mt19937 rng(11);
+  for (size_t n = 0; n < 200; n += 1 + n / 8) {
+    for (int round = 0; round < 20; ++round) {
+      string s(n, 'a');
+      for (auto& c : s) { c = static_cast<char>('a' + rng() % 2); }
+      for (size_t m = 1; m <= 9 && m <= n + 1; m += 2) {
+        string needle(m, 'a');
+        for (auto& c : needle) { c = static_cast<char>('a' + rng() % 2); }
+        EXPECT_EQ(RefFind(s, needle),
+                  kernels_->find_substring(s.data(), n, needle.data(), m));
+      }
+      if (n >= 5) {
+        size_t pos = rng() % (n - 4);
+        string needle = s.substr(pos, 5);
+        EXPECT_EQ(RefFind(s, needle),
+                  kernels_->find_substring(s.data(), n, needle.data(), 5));
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Isa, CharSearchTest,
+    testing::Values(SearchIsa::kScalar, SearchIsa::kSsse3, SearchIsa::kAvx2,
+                    SearchIsa::kAvx512));
+
+}  // namespace search_internal
+}  // namespace absl
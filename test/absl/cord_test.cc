@@ -0,0 +1,219 @@
+#include "absl/cord.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <sstream>
+
+
+namespace absl {
+
+static string Chunked(const Cord& c) {
+  string s;
+  for (string_view chunk : c.Chunks()) {
+    EXPECT_FALSE(chunk.empty());
+    s.append(chunk.data(), chunk.size());
+  }
+  return s;
+}
+
+TEST(CordTest, Empty) {
+  Cord c;
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(0u, c.size());
+  EXPECT_TRUE(c.Chunks().begin() == c.Chunks().end());
+  EXPECT_EQ("", string(c));
+  EXPECT_TRUE(Cord("").empty());
+  EXPECT_EQ(Cord(), Cord(""));
+}
+
+TEST(CordTest, Append) {
+  Cord c("hello");
+  c.Append(", ");
+  c.Append(string("world"));
+  c.Append(Cord("!"));
+  EXPECT_EQ(13u, c.size());
+  EXPECT_EQ("hello, world!", string(c));
+  EXPECT_EQ("hello, world!", c);
+  // Short appends share the chunk.
+  int chunks = 0;
+  c.ForEachChunk([&chunks](string_view) { ++chunks; });
+  EXPECT_EQ(1, chunks);
+}
+
+TEST(CordTest, AppendSharesLargePieces) {
+  string big(10000, 'x');
+  const char* data = big.data();
+  Cord c("head");
+  c.Append(std::move(big));
+  Cord copy = c;
+  Cord d;
+  d.Append(copy);
+  d.Append(copy);
+  EXPECT_EQ(20008u, d.size());
+  int owned = 0;
+  for (string_view chunk : d.Chunks()) { owned += chunk.data() == data; }
+  EXPECT_EQ(2, owned);
+  // Appending to a copy leaves the original alone.
+  copy.Append("tail");
+  EXPECT_EQ(10004u, c.size());
+  EXPECT_EQ(10008u, copy.size());
+  EXPECT_TRUE(copy.StartsWith("headxxx"));
+}
+
+TEST(CordTest, AppendSelf) {
+  Cord c("abc");
+  c.Append(c);
+  EXPECT_EQ("abcabc", c);
+  Cord big(string(100, 'y'));
+  big.Append(big);
+  big.Append(std::move(big));
+  EXPECT_EQ(string(400, 'y'), string(big));
+  big.Prepend(big);
+  EXPECT_EQ(800u, big.size());
+}
+
+TEST(CordTest, Prepend) {
+  Cord c("world");
+  c.Prepend("hello ");
+  c.Prepend(Cord(">> "));
+  EXPECT_EQ(">> hello world", string(c));
+}
+
+TEST(CordTest, Subcord) {
+  string text;
+  Cord c;
+  for (int i = 0; i < 50; ++i) {
+    string piece(200 + i, static_cast<char>('a' + i % 26));
+    text += piece;
+    c.Append(Cord(piece));
+  }
+  for (size_t pos : {0, 1, 199, 200, 5000, 10000}) {
+    for (size_t n : {0, 1, 10, 64, 65, 300, 5000, 100000}) {
+      Cord sub = c.Subcord(pos, n);
+      string expected = text.substr(pos, n);
+      EXPECT_EQ(expected, Chunked(sub)) << pos << " " << n;
+      EXPECT_EQ(expected.empty(), sub.empty());
+      if (expected.size() > 3) {
+        EXPECT_EQ(expected.substr(3, 80), string(sub.Subcord(3, 80)));
+      }
+    }
+  }
+  EXPECT_TRUE(c.Subcord(text.size(), 10).empty());
+}
+
+TEST(CordTest, SubcordSharesChunks) {
+  string big(100000, 'z');
+  Cord c(std::move(big));
+  string_view whole;
+  ASSERT_TRUE(c.TryFlat(&whole));
+  Cord sub = c.Subcord(1000, 5000);
+  string_view part;
+  ASSERT_TRUE(sub.TryFlat(&part));
+  EXPECT_EQ(whole.data() + 1000, part.data());
+  EXPECT_EQ(5000u, part.size());
+}
+
+TEST(CordTest, Flatten) {
+  Cord c;
+  for (int i = 0; i < 10; ++i) { c.Append(Cord(string(1000, '0' + i))); }
+  string_view flat;
+  EXPECT_FALSE(c.TryFlat(&flat));
+  string expected = string(c);
+  EXPECT_EQ(expected, c.Flatten());
+  EXPECT_TRUE(c.TryFlat(&flat));
+  EXPECT_EQ(expected, flat);
+}
+
+TEST(CordTest, External) {
+  static const char kText[] = "some buffer owned elsewhere, and long enough to "
+                              "be shared rather than copied";
+  int released = 0;
+  {
+    Cord c = MakeCordFromExternal(kText, [&released] { ++released; });
+    Cord copy = c;
+    Cord sub = c.Subcord(5, 70);
+    c.Clear();
+    copy.Clear();
+    EXPECT_EQ(0, released);
+    EXPECT_EQ(string(kText).substr(5, 70), string(sub));
+  }
+  EXPECT_EQ(1, released);
+  Cord empty = MakeCordFromExternal("", [&released] { ++released; });
+  EXPECT_EQ(2, released);
+}
+
+TEST(CordTest, Compare) {
+  Cord a("abc");
+  a.Append(Cord(string(100, 'd')));
+  string text = string(a);
+  EXPECT_EQ(0, a.Compare(text));
+  EXPECT_EQ(0, a.Compare(Cord(text)));
+  EXPECT_LT(a.Compare(text + "e"), 0);
+  EXPECT_GT(a.Compare(text.substr(0, 50)), 0);
+  EXPECT_LT(a.Compare("abd"), 0);
+  EXPECT_GT(a.Compare(Cord("abcc")), 0);
+  EXPECT_TRUE(Cord("a") < Cord("b"));
+  EXPECT_NE(a, Cord("abc"));
+  EXPECT_EQ('a', a[0]);
+  EXPECT_EQ('d', a[102]);
+  EXPECT_TRUE(a.StartsWith("abcdd"));
+  EXPECT_FALSE(a.StartsWith("abd"));
+}
+
+TEST(CordTest, Stream) {
+  Cord c("x = ");
+  c.Append(Cord(string(70, '1')));
+  std::ostringstream os;
+  os << c;
+  EXPECT_EQ(string(c), os.str());
+}
+
+TEST(CordTest, ManyAppendsStayShallow) {
+  Cord c;
+  string text;
+  for (int i = 0; i < 20000; ++i) {
+    string piece(65 + i % 7, static_cast<char>('a' + i % 26));
+    text += piece;
+    c.Append(Cord(piece));
+    if (i % 1000 == 0) { c.Prepend(Cord(piece)); text = piece + text; }
+  }
+  EXPECT_EQ(text, Chunked(c));
+}
+
+TEST(CordTest, RandomOperations) {
+  std::mt19937 rng(3);
+  for (int round = 0; round < 50; ++round) {
+    Cord c;
+    string model;
+    for (int step = 0; step < 100; ++step) {
+      size_t n = rng() % 3 == 0 ? rng() % 6000 : rng() % 100;
+      string piece(n, static_cast<char>('a' + rng() % 26));
+      switch (rng() % 5) {
+        case 0: c.Append(piece); model += piece; break;
+        case 1: c.Append(Cord(piece)); model += piece; break;
+        case 2: c.Prepend(piece); model = piece + model; break;
+        case 3: {
+          size_t pos = model.empty() ? 0 : rng() % model.size();
+          c = c.Subcord(pos, n * 10);
+          model = model.substr(pos, n * 10);
+          break;
+        }
+        case 4: {
+          Cord copy = c;
+          c.Append(copy);
+          model += model;
+          if (model.size() > 100000) {
+            c = c.Subcord(0, 50000);
+            model.resize(50000);
+          }
+          break;
+        }
+      }
+      ASSERT_EQ(model.size(), c.size());
+    }
+    EXPECT_EQ(model, Chunked(c));
+    EXPECT_EQ(model, string(c));
+  }
+}
+
+}  // namespace absl
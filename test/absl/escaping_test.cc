@@ -0,0 +1,124 @@
+#include "absl/escaping.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+
+namespace absl {
+
+TEST(EscapingTest, BytesToHexString) {
+  EXPECT_EQ("", BytesToHexString(string_view()));
+  EXPECT_EQ("00ff7f80", BytesToHexString(string_view("\x00\xff\x7f\x80", 4)));
+  EXPECT_EQ("616263", BytesToHexString("abc"));
+  // Long enough for the vectorized path, with a tail.
+  string bytes;
+  string expected;
+  for (int i = 0; i < 37; ++i) {
+    bytes.push_back(static_cast<char>(i * 7));
+    char hex[3];
+    snprintf(hex, sizeof(hex), "%02x", (i * 7) & 0xff);
+    expected += hex;
+  }
+  EXPECT_EQ(expected, BytesToHexString(bytes));
+}
+
+TEST(EscapingTest, Base64Escape) {
+  // Test vectors of RFC 4648.
+  EXPECT_EQ("", Base64Escape(""));
+  EXPECT_EQ("Zg==", Base64Escape("f"));
+  EXPECT_EQ("Zm8=", Base64Escape("fo"));
+  EXPECT_EQ("Zm9v", Base64Escape("foo"));
+  EXPECT_EQ("Zm9vYg==", Base64Escape("foob"));
+  EXPECT_EQ("Zm9vYmE=", Base64Escape("fooba"));
+  EXPECT_EQ("Zm9vYmFy", Base64Escape("foobar"));
+  EXPECT_EQ("Zm9vYmFyZm9vYmFyZg==", Base64Escape("foobarfoobarf"));
+  EXPECT_EQ("AP8/+w==", Base64Escape(string_view("\x00\xff\x3f\xfb", 4)));
+}
+
+TEST(EscapingTest, StreamHexBytes) {
+  std::stringstream ss;
+  string bytes(1000, '\x5a');
+  ss << HexBytes(bytes);
+  EXPECT_EQ(BytesToHexString(bytes), ss.str());
+}
+
+TEST(EscapingTest, StreamBase64Bytes) {
+  string bytes;
+  for (int i = 0; i < 1001; ++i) { bytes.push_back(static_cast<char>(i)); }
+  std::stringstream ss;
+  ss << Base64Bytes(bytes);
+  EXPECT_EQ(Base64Escape(bytes), ss.str());
+}
+
+TEST(EscapingTest, StreamHexDump) {
+  std::stringstream ss;
+  ss << HexDump("Hello world.\nThis is xenia.");
+  EXPECT_EQ(
+      "00000000  48 65 6c 6c 6f 20 77 6f  72 6c 64 2e 0a 54 68 69  "
+      "|Hello world..Thi|\n"
+      "00000010  73 20 69 73 20 78 65 6e  69 61 2e                 "
+      "|s is xenia.|\n",
+      ss.str());
+
+  ss.str("");
+  ss << HexDump("ab", 0x1f0);
+  EXPECT_EQ("000001f0  61 62                                             "
+            "|ab|\n", ss.str());
+
+  ss.str("");
+  ss << HexDump(string_view());
+  EXPECT_EQ("", ss.str());
+
+  ss.str("");
+  string bytes(16 * 100, 'x');
+  ss << HexDump(bytes);
+  EXPECT_EQ(100 * 79, ss.str().size());
+}
+
+using search_internal::SearchIsa;
+
+class Base64EncoderTest : public testing::TestWithParam<SearchIsa> {
+ protected:
+  void SetUp() override {
+    encoder_ = escaping_internal::GetBase64Encoder(GetParam());
+    if (encoder_ == nullptr) { GTEST_SKIP() << "Unsupported by the CPU"; }
+  }
+  escaping_internal::Base64Encoder encoder_ = nullptr;
+};
+
+TEST_P(Base64EncoderTest, MatchesScalar) {
+  const auto scalar = escaping_internal::GetBase64Encoder(SearchIsa::kScalar);
+  std::mt19937 rng(29);
+  string bytes(300, '\0');
+  for (char& c : bytes) { c = static_cast<char>(rng()); }
+  // The sextets 0 to 63 in order, so every char is in a vector.
+  for (uint32_t i = 0; i < 16; ++i) {
+    uint32_t word = (4 * i) << 18 | (4 * i + 1) << 12 | (4 * i + 2) << 6 |
+                    (4 * i + 3);
+    bytes[3 * i] = static_cast<char>(word >> 16);
+    bytes[3 * i + 1] = static_cast<char>(word >> 8);
+    bytes[3 * i + 2] = static_cast<char>(word);
+  }
+  EXPECT_EQ("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+            Base64Escape(string_view(bytes.data(), 48)));
+  string expected(Base64EncodedSize(bytes.size()), '\0');
+  string actual(expected.size(), '\0');
+  for (size_t offset = 0; offset < 32; ++offset) {
+    for (size_t n = 0; offset + n <= bytes.size(); ++n) {
+      string_view src(bytes.data() + offset, n);
+      const size_t size = scalar(src, &expected[0]);
+      ASSERT_EQ(Base64EncodedSize(n), size);
+      ASSERT_EQ(size, encoder_(src, &actual[0]));
+      ASSERT_EQ(string_view(expected.data(), size),
+                string_view(actual.data(), size))
+          << "offset " << offset << ", size " << n;
+    }
+  }
+}
+
+// There is no AVX-512 encoder; AVX2 runs at memory bandwidth already.
+INSTANTIATE_TEST_SUITE_P(
+    Isa, Base64EncoderTest,
+    testing::Values(SearchIsa::kScalar, SearchIsa::kSsse3, SearchIsa::kAvx2));
+
+}  // namespace absl
@@ -0,0 +1,185 @@
+#include "absl/flat_hash_map.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+
+namespace absl {
+
+TEST(FlatHashMapTest, Basic) {
+  flat_hash_map<int, int> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.begin(), m.end());
+  EXPECT_EQ(m.end(), m.find(1));
+  EXPECT_EQ(0, m.erase(1));
+  EXPECT_TRUE(m.insert({1, 10}).second);
+  EXPECT_FALSE(m.insert({1, 11}).second);
+  EXPECT_EQ(10, m[1]);
+  m[2] = 20;
+  EXPECT_EQ(2, m.size());
+  EXPECT_TRUE(m.contains(2));
+  EXPECT_EQ(20, m.at(2));
+  EXPECT_THROW(m.at(3), std::out_of_range);
+  EXPECT_EQ(1, m.erase(1));
+  EXPECT_FALSE(m.contains(1));
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(0, m.capacity());
+}
+
+TEST(FlatHashMapTest, StringKeysAndViewLookup) {
+  flat_hash_map<string, int> m = {{"http", 80}, {"ssh", 22}};
+  string line = "ssh://host";
+  auto it = m.find(string_view(line).substr(0, 3));
+  ASSERT_NE(m.end(), it);
+  EXPECT_EQ(22, it->second);
+  EXPECT_EQ(80, m.at("http"));
+  EXPECT_TRUE(m.contains(string("http")));
+  m[string_view("xftp").substr(1)] = 21;
+  EXPECT_EQ(21, m.at(string("ftp")));
+  EXPECT_EQ(1, m.erase(string_view("ftp")));
+  EXPECT_TRUE(m.try_emplace("dns", 53).second);
+  EXPECT_FALSE(m.try_emplace("dns", 54).second);
+  EXPECT_EQ(53, m["dns"]);
+  m.insert_or_assign("dns", 5353);
+  EXPECT_EQ(5353, m["dns"]);
+}
+
+TEST(FlatHashMapTest, MoveOnlyValues) {
+  flat_hash_map<int, std::unique_ptr<int>> m;
+  for (int i = 0; i < 100; ++i) { m.try_emplace(i, new int(i)); }
+  auto moved = std::move(m);
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(100, moved.size());
+  for (int i = 0; i < 100; ++i) { EXPECT_EQ(i, *moved[i]); }
+}
+
+// Counts the copies of the keys, which rehashing must not make.
+struct CountedKey {
+  static int copies;
+  explicit CountedKey(int v) : value(v) { }
+  CountedKey(const CountedKey& other) : value(other.value) { ++copies; }
+  CountedKey(CountedKey&& other) = default;
+  bool operator==(const CountedKey& other) const {
+    return value == other.value;
+  }
+  int value;
+};
+int CountedKey::copies = 0;
+
+struct CountedKeyHash {
+  size_t operator()(const CountedKey& k) const { return HashInt(k.value); }
+};
+
+TEST(FlatHashMapTest, RehashMovesKeys) {
+  flat_hash_map<CountedKey, int, CountedKeyHash> m;
+  for (int i = 0; i < 1000; ++i) { m.try_emplace(CountedKey(i), i); }
+  EXPECT_EQ(0, CountedKey::copies);
+  EXPECT_GE(m.capacity(), 1000);
+}
+
+TEST(FlatHashMapTest, EraseWhileIterating) {
+  flat_hash_map<int, int> m;
+  for (int i = 0; i < 1000; ++i) { m[i] = i; }
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->first % 3 == 0) {
+      m.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(666, m.size());
+  size_t count = 0;
+  for (const auto& kv : m) {
+    EXPECT_NE(0, kv.first % 3);
+    ++count;
+  }
+  EXPECT_EQ(666, count);
+}
+
+TEST(FlatHashMapTest, CopyAndReserve) {
+  flat_hash_map<string, int> m;
+  m.reserve(100);
+  const size_t capacity = m.capacity();
+  for (int i = 0; i < 100; ++i) { m[std::to_string(i)] = i; }
+  EXPECT_EQ(capacity, m.capacity());
+  flat_hash_map<string, int> copy(m);
+  EXPECT_EQ(100, copy.size());
+  for (int i = 0; i < 100; ++i) { EXPECT_EQ(i, copy.at(std::to_string(i))); }
+  copy = flat_hash_map<string, int>();
+  EXPECT_TRUE(copy.empty());
+  copy = m;
+  EXPECT_EQ(100, copy.size());
+}
+
+TEST(FlatHashMapTest, ReserveAndRehashEmpty) {
+  flat_hash_map<int, int> m;
+  m.rehash(10);
+  EXPECT_GE(m.capacity(), 10);
+  // An empty table with capacity.
+  m.rehash(100);
+  EXPECT_GE(m.capacity(), 100);
+  EXPECT_LT(m.capacity(), 1000);
+  m.reserve(200);
+  EXPECT_GE(m.capacity(), 200);
+  EXPECT_LT(m.capacity(), 1000);
+  EXPECT_TRUE(m.empty());
+
+  flat_hash_map<int, int> cleared;
+  for (int i = 0; i < 50; ++i) { cleared[i] = i; }
+  cleared.clear();
+  cleared.rehash(64);
+  EXPECT_GE(cleared.capacity(), 64);
+  EXPECT_LT(cleared.capacity(), 1000);
+  cleared.reserve(100);
+  EXPECT_GE(cleared.capacity(), 100);
+  EXPECT_LT(cleared.capacity(), 1000);
+  cleared[1] = 1;
+  EXPECT_EQ(1, cleared.at(1));
+  cleared.rehash(0);
+  EXPECT_EQ(1, cleared.size());
+}
+
+TEST(FlatHashMapTest, ChurnKeepsCapacity) {
+  // Inserting and erasing at a constant size reuses the deleted slots, or
+  // rehashes them away, instead of growing the table.
+  flat_hash_map<int, int> m;
+  for (int i = 0; i < 100; ++i) { m[i] = i; }
+  const size_t capacity = m.capacity();
+  for (int i = 100; i < 100000; ++i) {
+    m.erase(i - 100);
+    m[i] = i;
+  }
+  EXPECT_EQ(100, m.size());
+  EXPECT_EQ(capacity, m.capacity());
+}
+
+TEST(FlatHashMapTest, Random) {
+  std::mt19937 rng(36);
+  flat_hash_map<int, int> m;
+  std::unordered_map<int, int> expected;
+  for (int round = 0; round < 200000; ++round) {
+    int key = rng() % 2000;
+    switch (rng() % 4) {
+      case 0:
+      case 1:
+        m[key] = round;
+        expected[key] = round;
+        break;
+      case 2:
+        EXPECT_EQ(expected.erase(key), m.erase(key));
+        break;
+      default: {
+        auto it = m.find(key);
+        auto exp = expected.find(key);
+        ASSERT_EQ(exp == expected.end(), it == m.end());
+        if (it != m.end()) { EXPECT_EQ(exp->second, it->second); }
+      }
+    }
+    ASSERT_EQ(expected.size(), m.size());
+  }
+  std::unordered_map<int, int> contents(m.begin(), m.end());
+  EXPECT_EQ(expected, contents);
+}
+
+}  // namespace absl
@@ -0,0 +1,36 @@
+#include "absl/flat_hash_set.h"
+#include "gtest/gtest.h"
+
+
+namespace absl {
+
+TEST(FlatHashSetTest, Basic) {
+  flat_hash_set<int> s = {1, 2, 3};
+  EXPECT_EQ(3, s.size());
+  EXPECT_FALSE(s.insert(2).second);
+  EXPECT_TRUE(s.emplace(4).second);
+  EXPECT_TRUE(s.contains(4));
+  EXPECT_EQ(1, s.erase(1));
+  int sum = 0;
+  for (int v : s) { sum += v; }
+  EXPECT_EQ(9, sum);
+}
+
+TEST(FlatHashSetTest, StringViewLookup) {
+  flat_hash_set<string> s = {"alpha", "beta"};
+  EXPECT_TRUE(s.contains(string_view("xalpha").substr(1)));
+  EXPECT_TRUE(s.contains("beta"));
+  EXPECT_FALSE(s.contains("gamma"));
+  EXPECT_EQ(1, s.erase(string_view("beta")));
+  EXPECT_EQ(1, s.size());
+}
+
+TEST(FlatHashSetTest, Grow) {
+  flat_hash_set<uint64_t> s;
+  for (uint64_t i = 0; i < 100000; ++i) { s.insert(i << 32); }
+  EXPECT_EQ(100000, s.size());
+  for (uint64_t i = 0; i < 100000; ++i) { ASSERT_TRUE(s.contains(i << 32)); }
+  EXPECT_FALSE(s.contains(1));
+}
+
+}  // namespace absl
@@ -0,0 +1,128 @@
+#include "absl/glob.h"
+#include "gtest/gtest.h"
+
+#include <fnmatch.h>
+
+#include <random>
+
+
+namespace absl {
+
+TEST(GlobTest, Literal) {
+  EXPECT_TRUE(Glob("net.cc").Match("net.cc"));
+  EXPECT_FALSE(Glob("net.cc").Match("net.c"));
+  EXPECT_FALSE(Glob("net.cc").Match("xnet.cc"));
+  EXPECT_TRUE(Glob("").Match(""));
+  EXPECT_FALSE(Glob("").Match("a"));
+}
+
+TEST(GlobTest, Stars) {
+  EXPECT_TRUE(Glob("*").Match(""));
+  EXPECT_TRUE(Glob("*").Match("anything/at/all"));
+  EXPECT_TRUE(Glob("net_*").Match("net_"));
+  EXPECT_TRUE(Glob("net_*").Match("net_socket.cc"));
+  EXPECT_FALSE(Glob("net_*").Match("ne"));
+  EXPECT_TRUE(Glob("*_test.cc").Match("glob_test.cc"));
+  EXPECT_FALSE(Glob("*_test.cc").Match("glob_test.h"));
+  EXPECT_TRUE(Glob("*/base/*.cc").Match("source/base/logging.cc"));
+  EXPECT_FALSE(Glob("*/base/*.cc").Match("source/absl/logging.cc"));
+  EXPECT_TRUE(Glob("a**b").Match("ab"));
+  // The first and last parts may not overlap.
+  EXPECT_FALSE(Glob("ab*ba").Match("aba"));
+  EXPECT_TRUE(Glob("ab*ba").Match("abba"));
+  EXPECT_TRUE(Glob("*abc*abd*").Match("xxabcabcabdxx"));
+  EXPECT_FALSE(Glob("*abc*abd*").Match("xxabdabc"));
+}
+
+TEST(GlobTest, Classes) {
+  EXPECT_TRUE(Glob("file?.txt").Match("file1.txt"));
+  EXPECT_FALSE(Glob("file?.txt").Match("file.txt"));
+  EXPECT_TRUE(Glob("[a-c]x").Match("bx"));
+  EXPECT_FALSE(Glob("[a-c]x").Match("dx"));
+  EXPECT_TRUE(Glob("[!a-c]x").Match("dx"));
+  EXPECT_TRUE(Glob("[^a-c]x").Match("dx"));
+  EXPECT_FALSE(Glob("[!a-c]x").Match("ax"));
+  EXPECT_TRUE(Glob("[]]").Match("]"));
+  EXPECT_TRUE(Glob("[a-]").Match("-"));
+  EXPECT_TRUE(Glob("*[0-9][0-9]*.log").Match("run_42_b.log"));
+  EXPECT_FALSE(Glob("*[0-9][0-9]*.log").Match("run_4_b.log"));
+  // Without its ']', '[' is itself.
+  EXPECT_TRUE(Glob("a[b").Match("a[b"));
+  EXPECT_TRUE(Glob("\\*").Match("*"));
+  EXPECT_FALSE(Glob("\\*").Match("a"));
+  EXPECT_TRUE(Glob("[\\]]").Match("]"));
+}
+
+TEST(GlobTest, NoBacktracking) {
+  // A backtracking matcher takes exponential time on these.
+  string s(5000, 'a');
+  EXPECT_FALSE(Glob("a*a*a*a*a*a*a*a*a*a*a*a*b").Match(s));
+  EXPECT_FALSE(Glob("*?a?*?a?*?a?*?a?*?a?*b").Match(s));
+  s += 'b';
+  EXPECT_TRUE(Glob("a*a*a*a*a*a*a*a*a*a*a*a*b").Match(s));
+}
+
+TEST(GlobTest, MatchesFnmatch) {
+  std::mt19937 rng(49);
+  const char kPatternBytes[] = "ab*?[]!-\\";
+  for (int round = 0; round < 100000; ++round) {
+    string pattern;
+    for (size_t n = rng() % 9; n > 0; --n) {
+      pattern.push_back(kPatternBytes[rng() % (sizeof(kPatternBytes) - 1)]);
+    }
+    string s;
+    for (size_t n = rng() % 10; n > 0; --n) {
+      s.push_back("ab-]"[rng() % 4]);
+    }
+    // Patterns ending in a lone backslash are errors to fnmatch.
+    if (!pattern.empty() && pattern.back() == '\\') { continue; }
+    EXPECT_EQ(fnmatch(pattern.c_str(), s.c_str(), 0) == 0,
+              Glob(pattern).Match(s))
+        << "pattern " << pattern << " string " << s;
+  }
+}
+
+TEST(GlobSetTest, FirstMatch) {
+  GlobSet set;
+  EXPECT_EQ(GlobSet::npos, set.Match("anything"));
+  EXPECT_EQ(0u, set.Add("*_test.cc"));
+  EXPECT_EQ(1u, set.Add("net_*"));
+  EXPECT_EQ(2u, set.Add("net_socket.cc"));
+  EXPECT_EQ(3u, set.Add("net_socket*"));
+  EXPECT_EQ(4u, set.Add("*.cc"));
+  EXPECT_EQ(5u, set.Add("*"));
+  EXPECT_EQ(6u, set.Add("net_*"));
+  EXPECT_EQ(7u, set.size());
+  EXPECT_EQ(0u, set.Match("net_test.cc"));
+  EXPECT_EQ(1u, set.Match("net_socket.cc"));
+  EXPECT_EQ(4u, set.Match("logging.cc"));
+  EXPECT_EQ(5u, set.Match("logging.h"));
+}
+
+TEST(GlobSetTest, MatchesEachGlob) {
+  std::mt19937 rng(50);
+  std::vector<string> patterns;
+  GlobSet set;
+  for (int i = 0; i < 200; ++i) {
+    string pattern;
+    for (size_t n = rng() % 6; n > 0; --n) {
+      pattern.push_back("ab*?"[rng() % 4]);
+    }
+    patterns.push_back(pattern);
+    EXPECT_EQ(static_cast<size_t>(i), set.Add(pattern));
+  }
+  for (int round = 0; round < 2000; ++round) {
+    string s;
+    for (size_t n = rng() % 8; n > 0; --n) { s.push_back("abc"[rng() % 3]); }
+    size_t expected = GlobSet::npos;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+      if (Glob(patterns[i]).Match(s)) {
+        expected = i;
+        break;
+      }
+    }
+    EXPECT_EQ(expected, set.Match(s)) << s;
+  }
+}
+
+}  // namespace absl
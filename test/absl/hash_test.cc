@@ -0,0 +1,88 @@
+#include "absl/hash.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+
+namespace absl {
+
+TEST(HashTest, EqualBytesHashEqual) {
+  string s;
+  for (int i = 0; i < 300; ++i) {
+    s.push_back(static_cast<char>('a' + i % 26));
+    // The same bytes at another address, and unaligned.
+    string copy = "x" + s;
+    EXPECT_EQ(HashOf(s), HashOf(string_view(copy).substr(1)));
+    EXPECT_EQ(Hash<string>()(s), Hash<string_view>()(copy.substr(1)));
+    EXPECT_EQ(std::hash<string_view>()(s), Hash<string_view>()(s));
+  }
+  EXPECT_EQ(HashOf(string_view()), HashOf(""));
+}
+
+TEST(HashTest, Seed) {
+  EXPECT_NE(HashOf("abc", 1), HashOf("abc", 2));
+  EXPECT_EQ(HashOf("abc", 1), HashOf("abc", 1));
+}
+
+TEST(HashTest, NoCollisions) {
+  // Every length up to 100, with strings which differ in a single byte,
+  // zero bytes included.
+  std::unordered_set<uint64_t> hashes;
+  size_t count = 0;
+  for (size_t n = 0; n <= 100; ++n) {
+    string s(n, '\0');
+    hashes.insert(HashOf(s));
+    ++count;
+    for (size_t i = 0; i < n; ++i) {
+      for (int b : {1, 0x80}) {
+        s[i] = static_cast<char>(b);
+        hashes.insert(HashOf(s));
+        ++count;
+        s[i] = '\0';
+      }
+    }
+  }
+  EXPECT_EQ(count, hashes.size());
+}
+
+TEST(HashTest, Avalanche) {
+  // Flipping one input bit flips about half of the output bits.
+  std::mt19937_64 rng(35);
+  for (size_t n : {1, 3, 4, 8, 15, 16, 17, 33, 48, 49, 100}) {
+    double flipped = 0;
+    int trials = 0;
+    for (int round = 0; round < 40; ++round) {
+      string s;
+      for (size_t i = 0; i < n; ++i) { s.push_back(static_cast<char>(rng())); }
+      uint64_t h = HashOf(s);
+      for (size_t bit = 0; bit < n * 8; ++bit) {
+        s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        flipped += __builtin_popcountll(h ^ HashOf(s));
+        ++trials;
+        s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+      }
+    }
+    EXPECT_NEAR(32.0, flipped / trials, 1.0) << n;
+  }
+}
+
+TEST(HashTest, HashInt) {
+  // The low bits of consecutive integers all differ.
+  std::unordered_set<uint64_t> low_bits;
+  for (uint64_t i = 0; i < 4096; ++i) {
+    low_bits.insert(Hash<uint64_t>()(i) & 0xffffff);
+  }
+  EXPECT_GT(low_bits.size(), 4090);
+}
+
+TEST(HashTest, UnorderedMap) {
+  std::unordered_map<string_view, int> map;
+  string key = "alpha";
+  map[key] = 1;
+  map["beta"] = 2;
+  EXPECT_EQ(1, map.at(string_view("alpha")));
+  EXPECT_EQ(2, map.at(string_view("xbeta").substr(1)));
+  EXPECT_EQ(0, map.count("gamma"));
+}
+
+}  // namespace absl
@@ -0,0 +1,120 @@
+#include "absl/inlined_string.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace absl {
+
+using Small = InlinedString<15>;
+
+TEST(InlinedStringTest, Inline) {
+  Small s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.inlined());
+  EXPECT_STREQ("", s.c_str());
+  s = "fifteen chars!!";
+  EXPECT_EQ(15u, s.size());
+  EXPECT_TRUE(s.inlined());
+  EXPECT_EQ("fifteen chars!!", s);
+  EXPECT_STREQ("fifteen chars!!", s.c_str());
+  // The chars live in the object.
+  EXPECT_GE(s.data(), reinterpret_cast<const char*>(&s));
+  EXPECT_LT(s.data(), reinterpret_cast<const char*>(&s + 1));
+}
+
+TEST(InlinedStringTest, Spill) {
+  Small s("0123456789");
+  s.append("abcdef");
+  EXPECT_FALSE(s.inlined());
+  EXPECT_EQ("0123456789abcdef", s);
+  EXPECT_STREQ("0123456789abcdef", s.c_str());
+  s.push_back('!');
+  EXPECT_EQ(17u, s.size());
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  // The heap buffer is kept for reuse.
+  EXPECT_FALSE(s.inlined());
+  s = "short";
+  EXPECT_EQ("short", s);
+}
+
+TEST(InlinedStringTest, CopyAndMove) {
+  for (string text : {string("tiny"), string(40, 'x')}) {
+    Small a(text);
+    Small b(a);
+    EXPECT_EQ(a, b);
+    Small c(std::move(a));
+    EXPECT_EQ(text, string_view(c));
+    EXPECT_TRUE(a.empty());
+    Small d;
+    d = c;
+    EXPECT_EQ(c, d);
+    d = std::move(c);
+    EXPECT_EQ(text, string_view(d));
+    d = d;
+    EXPECT_EQ(text, string_view(d));
+    Small e("something else entirely, long");
+    e = std::move(d);
+    EXPECT_EQ(text, string_view(e));
+  }
+  std::vector<Small> v;
+  for (int i = 0; i < 100; ++i) {
+    v.emplace_back(string(i % 30, 'a' + i % 26));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(string(i % 30, 'a' + i % 26), string_view(v[i]));
+  }
+}
+
+TEST(InlinedStringTest, SelfAppend) {
+  Small s("abcdefgh");
+  s.append(s);
+  EXPECT_EQ("abcdefghabcdefgh", s);
+  s.append(s);
+  EXPECT_EQ("abcdefghabcdefghabcdefghabcdefgh", s);
+  s.assign(string_view(s).substr(8, 4));
+  EXPECT_EQ("abcd", s);
+}
+
+TEST(InlinedStringTest, Resize) {
+  Small s("ab");
+  s.resize(5);
+  EXPECT_EQ(string("ab\0\0\0", 5), string_view(s));
+  s.resize(1);
+  EXPECT_EQ("a", s);
+  s.reserve(100);
+  EXPECT_GE(s.capacity(), 100u);
+  EXPECT_EQ("a", s);
+}
+
+TEST(InlinedStringTest, Compare) {
+  Small a("abc");
+  Small b("abd");
+  EXPECT_TRUE(a == "abc");
+  EXPECT_TRUE("abc" == a);
+  EXPECT_TRUE(a != b);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(a == string_view("abc"));
+}
+
+TEST(InlinedStringTest, MatchesString) {
+  std::mt19937 rng(5);
+  Small s;
+  string model;
+  for (int i = 0; i < 2000; ++i) {
+    string piece(rng() % 12, static_cast<char>('a' + rng() % 26));
+    switch (rng() % 4) {
+      case 0: s.append(piece); model += piece; break;
+      case 1: s = piece; model = piece; break;
+      case 2: s.resize(model.size() / 2); model.resize(model.size() / 2); break;
+      case 3: s.push_back('x'); model.push_back('x'); break;
+    }
+    ASSERT_EQ(model, string_view(s));
+    ASSERT_EQ('\0', s.c_str()[s.size()]);
+  }
+}
+
+}  // namespace absl
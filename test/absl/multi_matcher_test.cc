@@ -0,0 +1,134 @@
+#include "absl/multi_matcher.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+
+namespace absl {
+
+using Match = MultiMatcher::Match;
+
+static std::vector<std::pair<size_t, size_t>> Pairs(
+    const std::vector<Match>& matches) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (const auto& m : matches) { pairs.emplace_back(m.pattern, m.position); }
+  return pairs;
+}
+
+// All matches in the documented order: by end, then longest first, then by
+// pattern index.
+static std::vector<std::pair<size_t, size_t>> BruteForce(
+    const std::vector<string_view>& patterns, string_view text) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t end = 1; end <= text.size(); ++end) {
+    for (size_t start = 0; start < end; ++start) {
+      for (size_t k = 0; k < patterns.size(); ++k) {
+        if (patterns[k].size() == end - start &&
+            text.substr(start, end - start) == patterns[k]) {
+          pairs.emplace_back(k, start);
+        }
+      }
+    }
+  }
+  return pairs;
+}
+
+TEST(MultiMatcherTest, FindAll) {
+  MultiMatcher matcher({"he", "she", "his", "hers"});
+  EXPECT_EQ(4, matcher.pattern_count());
+  std::vector<std::pair<size_t, size_t>> expected = {{1, 1}, {0, 2}, {3, 2}};
+  EXPECT_EQ(expected, Pairs(matcher.FindAll("ushers")));
+  EXPECT_TRUE(matcher.FindAll("").empty());
+  EXPECT_TRUE(matcher.FindAll("xyz").empty());
+}
+
+TEST(MultiMatcherTest, FindFirst) {
+  MultiMatcher matcher({"timeout", "error", "err"});
+  Match match;
+  ASSERT_TRUE(matcher.FindFirst("connect: error 5", &match));
+  EXPECT_EQ(2, match.pattern);
+  EXPECT_EQ(9, match.position);
+  EXPECT_FALSE(matcher.FindFirst("connect: ok", &match));
+  EXPECT_TRUE(matcher.Contains("read timeout"));
+  EXPECT_FALSE(matcher.Contains("read timeou"));
+}
+
+TEST(MultiMatcherTest, DuplicateAndEmptyPatterns) {
+  MultiMatcher matcher({"ab", "", "ab", "b"});
+  std::vector<std::pair<size_t, size_t>> expected = {{0, 1}, {2, 1}, {3, 2}};
+  EXPECT_EQ(expected, Pairs(matcher.FindAll("xab")));
+  MultiMatcher empty(std::vector<string_view>{});
+  EXPECT_FALSE(empty.Contains("abc"));
+}
+
+TEST(MultiMatcherTest, StopEarly) {
+  MultiMatcher matcher({"a"});
+  size_t calls = 0;
+  matcher.ForEachMatch("aaaa", [&](const Match&) { return ++calls < 2; });
+  EXPECT_EQ(2, calls);
+}
+
+TEST(MultiMatcherTest, AllBytes) {
+  string all;
+  for (int b = 0; b < 256; ++b) { all.push_back(static_cast<char>(b)); }
+  MultiMatcher matcher({string_view(all), string_view(all).substr(255)});
+  string text = all + all;
+  EXPECT_EQ(BruteForce({all, string_view(all).substr(255)}, text),
+            Pairs(matcher.FindAll(text)));
+}
+
+TEST(MultiMatcherTest, Random) {
+  std::mt19937 rng(33);
+  for (int round = 0; round < 300; ++round) {
+    // Few letters make overlaps and failure links common. They also make
+    // few first bytes, which keeps the prefilter on.
+    const int letters = 2 + rng() % 4;
+    const int count = 1 + rng() % (round % 2 ? 4 : 40);
+    std::vector<string> storage;
+    for (int k = 0; k < count; ++k) {
+      string pattern;
+      for (int i = rng() % 6; i > 0; --i) {
+        pattern.push_back('a' + rng() % letters);
+      }
+      storage.push_back(pattern);
+    }
+    std::vector<string_view> patterns(storage.begin(), storage.end());
+    string text;
+    for (int i = rng() % 200; i > 0; --i) {
+      text.push_back(rng() % 8 ? 'a' + rng() % letters : 'z');
+    }
+    MultiMatcher matcher(patterns);
+    ASSERT_EQ(BruteForce(patterns, text), Pairs(matcher.FindAll(text)))
+        << "text " << text;
+  }
+}
+
+// More first bytes than the prefilter takes, so that the automaton scans
+// every byte.
+TEST(MultiMatcherTest, RandomWithoutPrefilter) {
+  std::mt19937 rng(34);
+  for (int round = 0; round < 100; ++round) {
+    // The patterns start with 17 to 26 letters, and go on with a few, for
+    // overlaps.
+    const int first_letters = 17 + rng() % 10;
+    const int count = first_letters + rng() % 40;
+    std::vector<string> storage;
+    for (int k = 0; k < count; ++k) {
+      string pattern(1, 'a' + (k < first_letters ? k : rng() % first_letters));
+      for (int i = rng() % 5; i > 0; --i) {
+        pattern.push_back('a' + rng() % 3);
+      }
+      storage.push_back(pattern);
+    }
+    std::vector<string_view> patterns(storage.begin(), storage.end());
+    string text;
+    for (int i = rng() % 300; i > 0; --i) {
+      text.push_back(rng() % 4 ? 'a' + rng() % 3 : 'a' + rng() % 26);
+    }
+    MultiMatcher matcher(patterns);
+    ASSERT_EQ(BruteForce(patterns, text), Pairs(matcher.FindAll(text)))
+        << "text " << text;
+  }
+}
+
+}  // namespace absl
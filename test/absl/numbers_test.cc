@@ -0,0 +1,128 @@
+#include "absl/numbers.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+
+
+namespace absl {
+
+TEST(SimpleAtoiTest, Valid) {
+  int i = 0;
+  EXPECT_TRUE(SimpleAtoi("0", &i));
+  EXPECT_EQ(0, i);
+  EXPECT_TRUE(SimpleAtoi("-42", &i));
+  EXPECT_EQ(-42, i);
+  EXPECT_TRUE(SimpleAtoi(" +17\n", &i));
+  EXPECT_EQ(17, i);
+  EXPECT_TRUE(SimpleAtoi("2147483647", &i));
+  EXPECT_EQ(2147483647, i);
+  EXPECT_TRUE(SimpleAtoi("-2147483648", &i));
+  EXPECT_EQ(-2147483647 - 1, i);
+  EXPECT_TRUE(SimpleAtoi("0000000000000000000000000012", &i));
+  EXPECT_EQ(12, i);
+
+  int64_t i64 = 0;
+  EXPECT_TRUE(SimpleAtoi("-9223372036854775808", &i64));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), i64);
+  uint64_t u64 = 0;
+  EXPECT_TRUE(SimpleAtoi("18446744073709551615", &u64));
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(), u64);
+  EXPECT_TRUE(SimpleAtoi("1234567812345678", &u64));
+  EXPECT_EQ(1234567812345678ULL, u64);
+  uint8_t u8 = 0;
+  EXPECT_TRUE(SimpleAtoi("255", &u8));
+  EXPECT_EQ(255, u8);
+  EXPECT_TRUE(SimpleAtoi("-0", &u8));
+  EXPECT_EQ(0, u8);
+}
+
+TEST(SimpleAtoiTest, Invalid) {
+  int i = 5;
+  for (const char* s : {"", " ", "-", "+", "1a", "a1", "1 2", "--1", "0x10",
+                        "1.0", "2147483648", "-2147483649",
+                        "99999999999999999999999"}) {
+    EXPECT_FALSE(SimpleAtoi(s, &i)) << s;
+    EXPECT_EQ(5, i);
+  }
+  uint64_t u64;
+  EXPECT_FALSE(SimpleAtoi("18446744073709551616", &u64));
+  EXPECT_FALSE(SimpleAtoi("-1", &u64));
+  // Not NUL terminated.
+  EXPECT_TRUE(SimpleAtoi(string_view("123456", 3), &i));
+  EXPECT_EQ(123, i);
+}
+
+TEST(SimpleAtoiTest, Random) {
+  std::mt19937_64 rng(39);
+  for (int round = 0; round < 10000; ++round) {
+    int64_t v = static_cast<int64_t>(rng()) >> (rng() % 64);
+    int64_t parsed;
+    ASSERT_TRUE(SimpleAtoi(std::to_string(v), &parsed));
+    EXPECT_EQ(v, parsed);
+  }
+}
+
+TEST(SimpleAtodTest, Valid) {
+  double d = 0;
+  EXPECT_TRUE(SimpleAtod("1.5", &d));
+  EXPECT_EQ(1.5, d);
+  EXPECT_TRUE(SimpleAtod(" -2.5e3 ", &d));
+  EXPECT_EQ(-2500, d);
+  EXPECT_TRUE(SimpleAtod("+.25", &d));
+  EXPECT_EQ(0.25, d);
+  EXPECT_TRUE(SimpleAtod("1.", &d));
+  EXPECT_EQ(1, d);
+  EXPECT_TRUE(SimpleAtod("0.1", &d));
+  EXPECT_EQ(0.1, d);
+  EXPECT_TRUE(SimpleAtod("1e-400", &d));
+  EXPECT_EQ(0, d);
+  EXPECT_TRUE(SimpleAtod("inf", &d));
+  EXPECT_TRUE(std::isinf(d));
+  EXPECT_TRUE(SimpleAtod("nan", &d));
+  EXPECT_TRUE(std::isnan(d));
+  // Correctly rounded where a naive parse is off by an ulp.
+  EXPECT_TRUE(SimpleAtod("9007199254740993", &d));
+  EXPECT_EQ(9007199254740992.0, d);
+  EXPECT_TRUE(SimpleAtod("2.2250738585072011e-308", &d));
+  EXPECT_EQ(2.2250738585072011e-308, d);
+  float f = 0;
+  EXPECT_TRUE(SimpleAtof("3.4028235e38", &f));
+  EXPECT_EQ(3.4028235e38f, f);
+}
+
+TEST(SimpleAtodTest, Invalid) {
+  double d = 7;
+  for (const char* s : {"", "+", "-", ".", "e5", "1e", "1e+", "1.2.3", "1x",
+                        "+-1", "0x1p3", "1e400", "-1e400"}) {
+    EXPECT_FALSE(SimpleAtod(s, &d)) << s;
+    EXPECT_EQ(7, d);
+  }
+  float f;
+  EXPECT_FALSE(SimpleAtof("1e40", &f));
+}
+
+TEST(SimpleAtodTest, MatchesStrtod) {
+  std::mt19937_64 rng(39);
+  char buf[64];
+  for (int round = 0; round < 100000; ++round) {
+    double v;
+    uint64_t bits = rng();
+    memcpy(&v, &bits, sizeof(v));
+    if (!std::isfinite(v)) { continue; }
+    // Exact round trips, and short forms which take the fast path.
+    const char* format = round % 2 ? "%.17g" : "%.*g";
+    int precision = 1 + rng() % 16;
+    if (round % 2) {
+      snprintf(buf, sizeof(buf), format, v);
+    } else {
+      snprintf(buf, sizeof(buf), format, precision,
+               static_cast<double>(rng() % 1000000) / (1 + rng() % 1000));
+    }
+    double parsed;
+    ASSERT_TRUE(SimpleAtod(buf, &parsed)) << buf;
+    EXPECT_EQ(strtod(buf, nullptr), parsed) << buf;
+  }
+}
+
+}  // namespace absl
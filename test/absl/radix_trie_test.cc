@@ -0,0 +1,158 @@
+#include "absl/radix_trie.h"
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+
+namespace absl {
+
+static std::vector<std::pair<string, int>> Collect(const RadixTrie<int>& trie,
+                                                   string_view prefix) {
+  std::vector<std::pair<string, int>> out;
+  trie.ForEachWithPrefix(prefix, [&out](string_view key, int value) {
+    out.emplace_back(string(key), value);
+  });
+  return out;
+}
+
+TEST(RadixTrieTest, InsertAndFind) {
+  RadixTrie<int> trie;
+  EXPECT_TRUE(trie.empty());
+  EXPECT_TRUE(trie.insert("romane", 1).second);
+  EXPECT_TRUE(trie.insert("romanus", 2).second);
+  EXPECT_TRUE(trie.insert("romulus", 3).second);
+  EXPECT_TRUE(trie.insert("rom", 4).second);
+  EXPECT_TRUE(trie.insert("", 5).second);
+  auto result = trie.insert("romane", 10);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(1, *result.first);
+  EXPECT_EQ(5u, trie.size());
+  EXPECT_EQ(1, *trie.find("romane"));
+  EXPECT_EQ(2, *trie.find("romanus"));
+  EXPECT_EQ(3, *trie.find("romulus"));
+  EXPECT_EQ(4, *trie.find("rom"));
+  EXPECT_EQ(5, *trie.find(""));
+  EXPECT_EQ(nullptr, trie.find("roman"));
+  EXPECT_EQ(nullptr, trie.find("ro"));
+  EXPECT_EQ(nullptr, trie.find("romanes"));
+  EXPECT_FALSE(trie.contains("r"));
+  trie["roman"] = 6;
+  ++trie["roman"];
+  EXPECT_EQ(7, *trie.find("roman"));
+  *trie.find("rom") = 40;
+  EXPECT_EQ(40, *trie.find("rom"));
+}
+
+TEST(RadixTrieTest, LongestPrefix) {
+  RadixTrie<int> trie;
+  trie.insert("/api/", 1);
+  trie.insert("/api/users/", 2);
+  trie.insert("/static", 3);
+  size_t length = 99;
+  EXPECT_EQ(2, *trie.LongestPrefix("/api/users/42", &length));
+  EXPECT_EQ(11u, length);
+  EXPECT_EQ(1, *trie.LongestPrefix("/api/user", &length));
+  EXPECT_EQ(5u, length);
+  EXPECT_EQ(3, *trie.LongestPrefix("/static", &length));
+  EXPECT_EQ(7u, length);
+  EXPECT_EQ(nullptr, trie.LongestPrefix("/ap", &length));
+  EXPECT_EQ(0u, length);
+  trie.insert("", 0);
+  EXPECT_EQ(0, *trie.LongestPrefix("/other"));
+
+  std::vector<std::pair<size_t, int>> prefixes;
+  trie.ForEachPrefixOf("/api/users/42", [&](size_t length, int value) {
+    prefixes.emplace_back(length, value);
+  });
+  EXPECT_EQ((std::vector<std::pair<size_t, int>>{{0, 0}, {5, 1}, {11, 2}}),
+            prefixes);
+}
+
+TEST(RadixTrieTest, PrefixIteration) {
+  RadixTrie<int> trie;
+  const char* keys[] = {"b", "abc", "ab", "abd", "a", "ac", "abcd"};
+  int value = 0;
+  for (const char* key : keys) { trie.insert(key, value++); }
+  EXPECT_EQ((std::vector<std::pair<string, int>>{
+                {"a", 4}, {"ab", 2}, {"abc", 1}, {"abcd", 6}, {"abd", 3},
+                {"ac", 5}, {"b", 0}}),
+            Collect(trie, ""));
+  EXPECT_EQ((std::vector<std::pair<string, int>>{
+                {"ab", 2}, {"abc", 1}, {"abcd", 6}, {"abd", 3}}),
+            Collect(trie, "ab"));
+  EXPECT_EQ((std::vector<std::pair<string, int>>{{"abc", 1}, {"abcd", 6}}),
+            Collect(trie, "abc"));
+  // A prefix which ends inside a label.
+  trie.insert("xylophone", 7);
+  EXPECT_EQ((std::vector<std::pair<string, int>>{{"xylophone", 7}}),
+            Collect(trie, "xyl"));
+  EXPECT_TRUE(Collect(trie, "xz").empty());
+  EXPECT_TRUE(Collect(trie, "abcde").empty());
+}
+
+TEST(RadixTrieTest, WideNodes) {
+  RadixTrie<int> trie;
+  for (int b = 255; b >= 0; --b) {
+    trie.insert(string("k") + static_cast<char>(b), b);
+  }
+  EXPECT_EQ(256u, trie.size());
+  for (int b = 0; b < 256; ++b) {
+    EXPECT_EQ(b, *trie.find(string("k") + static_cast<char>(b)));
+  }
+  auto all = Collect(trie, "k");
+  ASSERT_EQ(256u, all.size());
+  for (int b = 0; b < 256; ++b) { EXPECT_EQ(b, all[b].second); }
+}
+
+TEST(RadixTrieTest, MatchesMap) {
+  std::mt19937 rng(9);
+  RadixTrie<int> trie;
+  std::map<string, int> model;
+  auto random_key = [&rng] {
+    string key(rng() % 12, '\0');
+    for (char& c : key) { c = static_cast<char>('a' + rng() % 4); }
+    return key;
+  };
+  for (int i = 0; i < 5000; ++i) {
+    string key = random_key();
+    EXPECT_EQ(model.emplace(key, i).second, trie.insert(key, i).second);
+  }
+  EXPECT_EQ(model.size(), trie.size());
+  for (int i = 0; i < 2000; ++i) {
+    string text = random_key();
+    auto it = model.find(text);
+    const int* found = trie.find(text);
+    ASSERT_EQ(it != model.end(), found != nullptr);
+    if (found != nullptr) { EXPECT_EQ(it->second, *found); }
+    // The longest prefix, by brute force.
+    const int* expected = nullptr;
+    size_t expected_length = 0;
+    for (size_t n = 0; n <= text.size(); ++n) {
+      auto prefix = model.find(text.substr(0, n));
+      if (prefix != model.end()) {
+        expected = &prefix->second;
+        expected_length = n;
+      }
+    }
+    size_t length;
+    const int* longest = trie.LongestPrefix(text, &length);
+    ASSERT_EQ(expected != nullptr, longest != nullptr);
+    if (longest != nullptr) {
+      EXPECT_EQ(*expected, *longest);
+      EXPECT_EQ(expected_length, length);
+    }
+    std::vector<std::pair<string, int>> under;
+    for (auto p = model.lower_bound(text);
+         p != model.end() && string_view(p->first).starts_with(text); ++p) {
+      under.push_back(*p);
+    }
+    EXPECT_EQ(under, Collect(trie, text));
+  }
+  trie.clear();
+  EXPECT_TRUE(trie.empty());
+  EXPECT_EQ(nullptr, trie.find(""));
+}
+
+}  // namespace absl
@@ -0,0 +1,79 @@
+#include "absl/searcher.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+
+namespace absl {
+
+static string_view::size_type npos = string_view::npos;
+
+TEST(SearcherTest, Find) {
+  Searcher searcher("abab");
+  EXPECT_EQ("abab", searcher.needle());
+  EXPECT_EQ(npos, searcher.Find(""));
+  EXPECT_EQ(npos, searcher.Find("aba"));
+  EXPECT_EQ(0, searcher.Find("abab"));
+  EXPECT_EQ(2, searcher.Find("aaabababab"));
+  EXPECT_EQ(4, searcher.Find("aaabababab", 3));
+  EXPECT_EQ(6, searcher.Find("aaabababab", 6));
+  EXPECT_EQ(npos, searcher.Find("aaabababab", 7));
+  EXPECT_EQ(npos, searcher.Find("aaabababab", 20));
+}
+
+TEST(SearcherTest, RFind) {
+  Searcher searcher("abab");
+  EXPECT_EQ(npos, searcher.RFind(""));
+  EXPECT_EQ(0, searcher.RFind("abab"));
+  EXPECT_EQ(6, searcher.RFind("aaabababab"));
+  EXPECT_EQ(4, searcher.RFind("aaabababab", 5));
+  EXPECT_EQ(2, searcher.RFind("aaabababab", 2));
+  EXPECT_EQ(npos, searcher.RFind("aaabababab", 1));
+}
+
+TEST(SearcherTest, EmptyNeedle) {
+  Searcher searcher("");
+  EXPECT_EQ(0, searcher.Find(""));
+  EXPECT_EQ(2, searcher.Find("abc", 2));
+  EXPECT_EQ(3, searcher.Find("abc", 3));
+  EXPECT_EQ(npos, searcher.Find("abc", 4));
+  EXPECT_EQ(3, searcher.RFind("abc"));
+  EXPECT_EQ(1, searcher.RFind("abc", 1));
+}
+
+TEST(SearcherTest, Random) {
+  // Small alphabets give periodic needles and many partial matches.
+  std::mt19937 rng(3);
+  for (int round = 0; round < 3000; ++round) {
+    int alphabet = 1 + rng() % 3;
+    string haystack(rng() % 200, 'a');
+    for (auto& c : haystack) { c = static_cast<char>('a' + rng() % alphabet); }
+    string needle(1 + rng() % 12, 'a');
+    for (auto& c : needle) { c = static_cast<char>('a' + rng() % alphabet); }
+    Searcher searcher(needle);
+    size_t pos = rng() % (haystack.size() + 2);
+    EXPECT_EQ(haystack.find(needle, pos), searcher.Find(haystack, pos))
+        << haystack << " " << needle << " " << pos;
+    EXPECT_EQ(haystack.rfind(needle, pos), searcher.RFind(haystack, pos))
+        << haystack << " " << needle << " " << pos;
+    EXPECT_EQ(haystack.rfind(needle), searcher.RFind(haystack))
+        << haystack << " " << needle;
+  }
+}
+
+TEST(SearcherTest, StringViewLongNeedle) {
+  // Long enough for string_view to search with Two-Way.
+  string haystack(5000, 'a');
+  string needle(100, 'a');
+  needle[50] = 'b';
+  EXPECT_EQ(npos, string_view(haystack).find(needle));
+  EXPECT_EQ(npos, string_view(haystack).rfind(needle));
+  haystack.replace(1234, needle.size(), needle);
+  haystack.replace(3000, needle.size(), needle);
+  EXPECT_EQ(1234, string_view(haystack).find(needle));
+  EXPECT_EQ(3000, string_view(haystack).find(needle, 1235));
+  EXPECT_EQ(3000, string_view(haystack).rfind(needle));
+  EXPECT_EQ(1234, string_view(haystack).rfind(needle, 2999));
+}
+
+}  // namespace absl
@@ -0,0 +1,55 @@
+#include "absl/str_cat.h"
+#include "gtest/gtest.h"
+
+#include <climits>
+#include <random>
+
+
+namespace absl {
+
+TEST(StrCatTest, Strings) {
+  string s = "str";
+  EXPECT_EQ("", StrCat());
+  EXPECT_EQ("str", StrCat(s));
+  EXPECT_EQ("a:str", StrCat("a", ":", s));
+  EXPECT_EQ("abcdefg",
+            StrCat("a", string_view("b"), string("c"), "d", "e", "f", "g"));
+  EXPECT_EQ("ab", StrCat("", "a", string_view(), "b"));
+}
+
+TEST(StrCatTest, Integers) {
+  EXPECT_EQ("0", StrCat(0));
+  EXPECT_EQ("-1 1", StrCat(-1, " ", 1u));
+  EXPECT_EQ("9 10 99 100 12345",
+            StrCat(9, " ", 10, " ", 99, " ", 100, " ", 12345L));
+  EXPECT_EQ("-9223372036854775808", StrCat(LLONG_MIN));
+  EXPECT_EQ("18446744073709551615", StrCat(ULLONG_MAX));
+  EXPECT_EQ("-2147483648", StrCat(INT_MIN));
+}
+
+TEST(StrCatTest, RandomIntegers) {
+  std::mt19937_64 rng(38);
+  for (int i = 0; i < 10000; ++i) {
+    int64_t v = static_cast<int64_t>(rng()) >> (rng() % 64);
+    EXPECT_EQ(std::to_string(v), StrCat(v));
+    uint64_t u = rng() >> (rng() % 64);
+    EXPECT_EQ(std::to_string(u), StrCat(u));
+  }
+}
+
+TEST(StrCatTest, Floats) {
+  EXPECT_EQ("0.5 1e+20 3.14159 -2", StrCat(0.5, " ", 1e20, " ", 3.14159265,
+                                           " ", -2.0f));
+}
+
+TEST(StrAppendTest, Append) {
+  string s = "x=";
+  StrAppend(&s, 1);
+  EXPECT_EQ("x=1", s);
+  StrAppend(&s, ",", "y=", 2);
+  EXPECT_EQ("x=1,y=2", s);
+  StrAppend(&s, ",", "z=", 3, ",", "w=", 4);
+  EXPECT_EQ("x=1,y=2,z=3,w=4", s);
+}
+
+}  // namespace absl
@@ -0,0 +1,77 @@
+#include "absl/str_split.h"
+#include "gtest/gtest.h"
+
+
+namespace absl {
+
+using Pieces = std::vector<string_view>;
+
+TEST(StrSplitTest, ByChar) {
+  EXPECT_EQ(Pieces({"a", "b", "c"}), Pieces(StrSplit("a,b,c", ',')));
+  EXPECT_EQ(Pieces({"", "a", "", "b", ""}), Pieces(StrSplit(",a,,b,", ',')));
+  EXPECT_EQ(Pieces({"abc"}), Pieces(StrSplit("abc", ',')));
+  EXPECT_EQ(Pieces({""}), Pieces(StrSplit("", ',')));
+  EXPECT_EQ(Pieces({}), Pieces(StrSplit("", ',', SkipEmpty())));
+  EXPECT_EQ(Pieces({"a", "b"}), Pieces(StrSplit(",a,,b,", ',', SkipEmpty())));
+}
+
+TEST(StrSplitTest, ByString) {
+  EXPECT_EQ(Pieces({"a", "b", "c"}), Pieces(StrSplit("a::b::c", "::")));
+  EXPECT_EQ(Pieces({"a", ":b"}), Pieces(StrSplit("a:::b", "::")));
+  string delimiter = ", ";
+  EXPECT_EQ(Pieces({"x", "y"}), Pieces(StrSplit("x, y", delimiter)));
+  EXPECT_EQ(Pieces({"x", "y"}), Pieces(StrSplit("x, y", ByString(", "))));
+  EXPECT_EQ(Pieces({"a", "b", "c"}), Pieces(StrSplit("abc", "")));
+  EXPECT_EQ(Pieces({""}), Pieces(StrSplit("", "")));
+}
+
+TEST(StrSplitTest, ByAnyChar) {
+  EXPECT_EQ(Pieces({"a", "b", "", "c"}),
+            Pieces(StrSplit("a b\t\tc", ByAnyChar(" \t"))));
+  EXPECT_EQ(Pieces({"a", "b", "c"}),
+            Pieces(StrSplit("a b\t\tc", ByAnyChar(" \t"), SkipEmpty())));
+  // Longer than the vectors of the kernels.
+  string text(100, 'x');
+  text[70] = ';';
+  Pieces pieces = StrSplit(text, ByAnyChar(";|"));
+  ASSERT_EQ(2, pieces.size());
+  EXPECT_EQ(70, pieces[0].size());
+  EXPECT_EQ(29, pieces[1].size());
+}
+
+TEST(StrSplitTest, ByLength) {
+  EXPECT_EQ(Pieces({"abc", "def", "g"}),
+            Pieces(StrSplit("abcdefg", ByLength(3))));
+  EXPECT_EQ(Pieces({"abc", "def"}), Pieces(StrSplit("abcdef", ByLength(3))));
+  EXPECT_EQ(Pieces({"ab"}), Pieces(StrSplit("ab", ByLength(3))));
+}
+
+TEST(StrSplitTest, SkipWhitespace) {
+  EXPECT_EQ(Pieces({"a", " b "}),
+            Pieces(StrSplit("a, ,\t, b ,", ',', SkipWhitespace())));
+}
+
+TEST(StrSplitTest, Views) {
+  string text = "key=value";
+  Pieces pieces = StrSplit(text, '=');
+  ASSERT_EQ(2, pieces.size());
+  EXPECT_EQ(text.data(), pieces[0].data());
+  EXPECT_EQ(text.data() + 4, pieces[1].data());
+}
+
+TEST(StrSplitTest, Strings) {
+  std::vector<string> pieces = StrSplit("a,b", ',');
+  EXPECT_EQ(std::vector<string>({"a", "b"}), pieces);
+}
+
+TEST(StrSplitTest, Lazy) {
+  // Stopping early leaves the rest of the text unscanned.
+  size_t count = 0;
+  for (string_view piece : StrSplit("a,b,c,d", ',')) {
+    if (piece == "b") { break; }
+    ++count;
+  }
+  EXPECT_EQ(1, count);
+}
+
+}  // namespace absl
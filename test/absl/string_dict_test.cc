@@ -0,0 +1,188 @@
+#include "absl/string_dict.h"
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+
+namespace absl {
+
+static string Build(const std::map<string, string>& entries,
+                    size_t block_size) {
+  StringDictBuilder builder(block_size);
+  for (const auto& entry : entries) { builder.Add(entry.first, entry.second); }
+  string bytes;
+  EXPECT_TRUE(builder.Build(&bytes));
+  return bytes;
+}
+
+TEST(StringDictTest, Lookup) {
+  StringDictBuilder builder(2);
+  builder.Add("romulus", "3");
+  builder.Add("romane", "1");
+  builder.Add("rom");
+  builder.Add("romanus", "2");
+  builder.Add("", "empty");
+  string bytes;
+  ASSERT_TRUE(builder.Build(&bytes));
+
+  StringDict dict;
+  ASSERT_TRUE(dict.Init(bytes));
+  EXPECT_EQ(5u, dict.size());
+  string_view value;
+  EXPECT_TRUE(dict.Lookup("romane", &value));
+  EXPECT_EQ("1", value);
+  EXPECT_TRUE(dict.Lookup("romanus", &value));
+  EXPECT_EQ("2", value);
+  EXPECT_TRUE(dict.Lookup("romulus", &value));
+  EXPECT_EQ("3", value);
+  EXPECT_TRUE(dict.Lookup("rom", &value));
+  EXPECT_EQ("", value);
+  EXPECT_TRUE(dict.Lookup("", &value));
+  EXPECT_EQ("empty", value);
+  EXPECT_FALSE(dict.Lookup("roman", &value));
+  EXPECT_FALSE(dict.Lookup("romulusx", &value));
+  EXPECT_FALSE(dict.Lookup("zz", &value));
+
+  // The values are views into the data.
+  dict.Lookup("romane", &value);
+  EXPECT_GE(value.data(), bytes.data());
+  EXPECT_LT(value.data(), bytes.data() + bytes.size());
+}
+
+TEST(StringDictTest, KeysInOrder) {
+  StringDictBuilder builder(3);
+  for (const char* key : {"b", "abc", "ab", "a", "abd", "c", "bcd"}) {
+    builder.Add(key);
+  }
+  string bytes;
+  ASSERT_TRUE(builder.Build(&bytes));
+  StringDict dict;
+  ASSERT_TRUE(dict.Init(bytes));
+  std::vector<string> keys;
+  string buffer;
+  for (size_t i = 0; i < dict.size(); ++i) {
+    keys.emplace_back(dict.Key(i, &buffer));
+    EXPECT_EQ(i, dict.Find(keys.back()));
+  }
+  EXPECT_EQ((std::vector<string>{"a", "ab", "abc", "abd", "b", "bcd", "c"}),
+            keys);
+  EXPECT_EQ(0u, dict.LowerBound(""));
+  EXPECT_EQ(3u, dict.LowerBound("abcd"));
+  EXPECT_EQ(4u, dict.LowerBound("abz"));
+  EXPECT_EQ(6u, dict.LowerBound("c"));
+  EXPECT_EQ(7u, dict.LowerBound("d"));
+}
+
+TEST(StringDictTest, Empty) {
+  StringDictBuilder builder;
+  string bytes;
+  ASSERT_TRUE(builder.Build(&bytes));
+  StringDict dict;
+  ASSERT_TRUE(dict.Init(bytes));
+  EXPECT_TRUE(dict.empty());
+  EXPECT_EQ(StringDict::npos, dict.Find(""));
+  EXPECT_EQ(0u, dict.LowerBound("a"));
+}
+
+TEST(StringDictTest, DuplicateKeys) {
+  StringDictBuilder builder;
+  builder.Add("a", "1");
+  builder.Add("b");
+  builder.Add("a", "2");
+  string bytes;
+  EXPECT_FALSE(builder.Build(&bytes));
+}
+
+TEST(StringDictTest, RejectsBadData) {
+  StringDict dict;
+  EXPECT_FALSE(dict.Init(""));
+  EXPECT_FALSE(dict.Init("not a dictionary at all, not at all"));
+  string bytes = Build({{"a", "1"}, {"b", "2"}}, 16);
+  EXPECT_FALSE(dict.Init(string_view(bytes).substr(0, bytes.size() - 1)));
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    // Any single corrupted byte is either caught or harmless.
+    string bad = bytes;
+    bad[i] ^= 0x5a;
+    if (dict.Init(bad)) {
+      string_view value;
+      dict.Lookup("a", &value);
+      dict.Lookup("b", &value);
+      string buffer;
+      dict.Key(1, &buffer);
+    }
+  }
+}
+
+// Init reads only the header, and bad offsets are caught as they are used.
+TEST(StringDictTest, BadOffsetsAfterInit) {
+  const string bytes = Build({{"a", "1"}, {"b", "22"}, {"c", "333"}}, 1);
+  const uint32_t index_offset = static_cast<unsigned char>(bytes[20]);
+  const uint32_t values_offset = static_cast<unsigned char>(bytes[24]);
+  ASSERT_EQ(0, bytes[21] | bytes[22] | bytes[23] | bytes[25] | bytes[26] |
+                   bytes[27]);
+  StringDict dict;
+  string_view value;
+
+  // The end of the last value, past the values.
+  string bad = bytes;
+  bad[values_offset + 12] = '\x7f';
+  ASSERT_TRUE(dict.Init(bad));
+  EXPECT_EQ("1", dict.Value(0));
+  EXPECT_EQ("22", dict.Value(1));
+  EXPECT_EQ("", dict.Value(2));
+  EXPECT_TRUE(dict.Lookup("c", &value));
+  EXPECT_EQ("", value);
+
+  // The start of the second block, past the blocks.
+  bad = bytes;
+  bad[index_offset + 4] = '\x7f';
+  ASSERT_TRUE(dict.Init(bad));
+  EXPECT_EQ(StringDict::npos, dict.Find("a"));
+  EXPECT_EQ(StringDict::npos, dict.Find("b"));
+  EXPECT_EQ(2u, dict.Find("c"));
+  string buffer;
+  EXPECT_EQ("", dict.Key(0, &buffer));
+  EXPECT_EQ("c", dict.Key(2, &buffer));
+}
+
+TEST(StringDictTest, MatchesMap) {
+  std::mt19937 rng(47);
+  std::map<string, string> entries;
+  for (int i = 0; i < 3000; ++i) {
+    // Keys over few letters share long prefixes.
+    string key;
+    for (size_t n = rng() % 12; n > 0; --n) {
+      key.push_back("abc/"[rng() % 4]);
+    }
+    entries[key] = std::to_string(i);
+  }
+  for (size_t block_size : {1, 4, 16, 100}) {
+    string bytes = Build(entries, block_size);
+    StringDict dict;
+    ASSERT_TRUE(dict.Init(bytes));
+    ASSERT_EQ(entries.size(), dict.size());
+    size_t i = 0;
+    string buffer;
+    for (const auto& entry : entries) {
+      EXPECT_EQ(entry.first, dict.Key(i, &buffer));
+      EXPECT_EQ(entry.second, dict.Value(i));
+      EXPECT_EQ(i, dict.Find(entry.first));
+      ++i;
+    }
+    for (int k = 0; k < 1000; ++k) {
+      string probe;
+      for (size_t n = rng() % 14; n > 0; --n) {
+        probe.push_back("abcd/"[rng() % 5]);
+      }
+      auto it = entries.lower_bound(probe);
+      size_t expected = std::distance(entries.begin(), it);
+      EXPECT_EQ(expected, dict.LowerBound(probe)) << probe;
+      bool present = it != entries.end() && it->first == probe;
+      EXPECT_EQ(present ? expected : StringDict::npos, dict.Find(probe));
+    }
+  }
+}
+
+}  // namespace absl
@@ -0,0 +1,90 @@
+#include "absl/string_sort.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+
+
+namespace absl {
+
+static std::vector<string_view> Views(const std::vector<string>& strings) {
+  return std::vector<string_view>(strings.begin(), strings.end());
+}
+
+static void ExpectSorts(const std::vector<string>& strings) {
+  std::vector<string_view> expected = Views(strings);
+  std::sort(expected.begin(), expected.end());
+  std::vector<string_view> sorted = Views(strings);
+  SortStrings(&sorted);
+  EXPECT_EQ(expected, sorted);
+  for (int threads : {2, 3, 8}) {
+    std::vector<string_view> parallel = Views(strings);
+    ParallelSortStrings(&parallel, threads);
+    EXPECT_EQ(expected, parallel) << threads;
+  }
+}
+
+TEST(StringSortTest, Small) {
+  ExpectSorts({});
+  ExpectSorts({"b", "a"});
+  ExpectSorts({"banana", "apple", "cherry", "apple", "", "app", "applesauce"});
+}
+
+TEST(StringSortTest, Nuls) {
+  // Zeros pad the cached bytes; they must still sort after the end.
+  std::vector<string> strings;
+  for (int n = 0; n < 40; ++n) {
+    strings.push_back(string(n, '\0'));
+    strings.push_back(string(n, '\0') + "a");
+    strings.push_back("a" + string(n, '\0'));
+  }
+  std::shuffle(strings.begin(), strings.end(), std::mt19937(1));
+  ExpectSorts(strings);
+}
+
+TEST(StringSortTest, SharedPrefixes) {
+  std::mt19937 rng(2);
+  std::vector<string> strings;
+  string prefix(100, 'p');
+  for (int i = 0; i < 5000; ++i) {
+    strings.push_back(prefix.substr(0, rng() % 101) +
+                      std::to_string(rng() % 1000));
+  }
+  ExpectSorts(strings);
+}
+
+TEST(StringSortTest, Random) {
+  std::mt19937 rng(3);
+  std::vector<string> strings;
+  for (int i = 0; i < 200000; ++i) {
+    string s(rng() % 24, '\0');
+    for (char& c : s) { c = static_cast<char>(rng() % 4 == 0 ? rng() : 'a'); }
+    strings.push_back(s);
+  }
+  ExpectSorts(strings);
+}
+
+TEST(StringSortTest, Duplicates) {
+  std::vector<string> strings(100000, "same key");
+  strings.push_back("other");
+  ExpectSorts(strings);
+}
+
+TEST(StringSortTest, Unique) {
+  std::mt19937 rng(4);
+  std::vector<string> strings;
+  for (int i = 0; i < 100000; ++i) {
+    strings.push_back("key" + std::to_string(rng() % 5000));
+  }
+  std::vector<string_view> expected = Views(strings);
+  std::sort(expected.begin(), expected.end());
+  expected.erase(std::unique(expected.begin(), expected.end()),
+                 expected.end());
+  for (int threads : {1, 4}) {
+    std::vector<string_view> unique = Views(strings);
+    SortUniqueStrings(&unique, threads);
+    EXPECT_EQ(expected, unique);
+  }
+}
+
+}  // namespace absl
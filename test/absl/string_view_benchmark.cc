@@ -0,0 +1,259 @@
+#include "absl/string_view.h"
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string_view>
+
+
+// Benchmarks absl::string_view against std::string_view, std::string and
+// the libc functions which do the same work. Prints JSON by default, for
+// the regression checks; --benchmark_format=console reads better.
+//
+//   string_view_benchmark --benchmark_filter=Find/ --benchmark_out=sv.json
+//
+// The haystacks range from 16B to 16MB. Each search scans all of it: the
+// needle is only at the far end, marked by a byte the rest of the text does
+// not have, or missing, or the text is a single repeated byte which the
+// needle almost matches everywhere. The setup checks that with std::string.
+
+namespace absl {
+namespace {
+
+enum Case { kHit, kMiss, kRepetitive };
+
+const std::vector<int64_t> kSizes = {16, 256, 4 << 10, 64 << 10, 1 << 20,
+                                     16 << 20};
+
+// Random lowercase letters, or 'a' repeated. Kept around across runs, so
+// that 16MB is only generated once.
+const std::string& Haystack(size_t n, bool repetitive) {
+  static std::map<std::pair<size_t, bool>, std::string> cache;
+  std::string& s = cache[{n, repetitive}];
+  if (s.size() != n) {
+    if (repetitive) {
+      s.assign(n, 'a');
+    } else {
+      std::mt19937 rng(static_cast<uint32_t>(n));
+      s.resize(n);
+      for (char& c : s) { c = static_cast<char>('a' + rng() % 26); }
+    }
+  }
+  return s;
+}
+
+// Random lowercase letters between '#' and '$', so that a needle which ends
+// with the last byte, or starts with the first, is only found there, even
+// a needle of one byte.
+const std::string& MarkedHaystack(size_t n) {
+  static std::map<size_t, std::string> cache;
+  std::string& s = cache[n];
+  if (s.size() != n) {
+    s = Haystack(n, false);
+    s.front() = '#';
+    s.back() = '$';
+  }
+  return s;
+}
+
+// The m bytes at the end of the haystack for find, or at its start for
+// rfind, with the byte furthest in changed for a miss.
+std::string Needle(const std::string& haystack, size_t m, Case c,
+                   bool reverse) {
+  std::string needle = reverse ? haystack.substr(0, m)
+                               : haystack.substr(haystack.size() - m);
+  char& last = reverse ? needle.front() : needle.back();
+  if (c == kMiss) { last = '#'; }
+  if (c == kRepetitive) { last = 'b'; }
+  return needle;
+}
+
+void SearchArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"size", "needle", "case"});
+  for (int64_t size : kSizes) {
+    // Needles of up to 32 bytes take the SIMD kernels, and longer ones in
+    // haystacks of 256 bytes or more the Two-Way search.
+    for (int64_t m : {1, 4, 32, 64, 256, 4096}) {
+      if (m > size) { continue; }
+      for (int64_t c : {kHit, kMiss, kRepetitive}) { b->Args({size, m, c}); }
+    }
+  }
+}
+
+void SizeArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"size"});
+  for (int64_t size : kSizes) { b->Args({size}); }
+}
+
+const std::string& SearchHaystack(size_t n, Case c) {
+  return c == kHit ? MarkedHaystack(n) : Haystack(n, c == kRepetitive);
+}
+
+struct SearchInput {
+  SearchInput(const benchmark::State& state, bool reverse)
+      : haystack(SearchHaystack(state.range(0),
+                                static_cast<Case>(state.range(2)))),
+        needle(Needle(haystack, state.range(1),
+                      static_cast<Case>(state.range(2)), reverse)) {
+    // A needle found early would not scan the haystack, and the bytes per
+    // second would be wrong.
+    const size_t expected = state.range(2) != kHit ? std::string::npos
+                            : reverse ? 0 : haystack.size() - needle.size();
+    const size_t found = reverse ? haystack.rfind(needle)
+                                 : haystack.find(needle);
+    if (found != expected) {
+      fprintf(stderr, "The needle is at %zu of %zu, not at %zu\n", found,
+              haystack.size(), expected);
+      abort();
+    }
+  }
+  const std::string& haystack;
+  std::string needle;
+};
+
+template <typename View>
+void BM_Find(benchmark::State& state) {
+  SearchInput input(state, false);
+  View haystack(input.haystack.data(), input.haystack.size());
+  View needle(input.needle.data(), input.needle.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(haystack.find(needle));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Find, absl::string_view)->Apply(SearchArgs);
+BENCHMARK_TEMPLATE(BM_Find, std::string_view)->Apply(SearchArgs);
+BENCHMARK_TEMPLATE(BM_Find, std::string)->Apply(SearchArgs);
+
+void BM_FindMemmem(benchmark::State& state) {
+  SearchInput input(state, false);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(memmem(input.haystack.data(),
+                                    input.haystack.size(),
+                                    input.needle.data(), input.needle.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindMemmem)->Apply(SearchArgs);
+
+template <typename View>
+void BM_RFind(benchmark::State& state) {
+  SearchInput input(state, true);
+  View haystack(input.haystack.data(), input.haystack.size());
+  View needle(input.needle.data(), input.needle.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(haystack.rfind(needle));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_RFind, absl::string_view)->Apply(SearchArgs);
+BENCHMARK_TEMPLATE(BM_RFind, std::string_view)->Apply(SearchArgs);
+BENCHMARK_TEMPLATE(BM_RFind, std::string)->Apply(SearchArgs);
+
+// A byte search which only hits at the last byte.
+template <typename View>
+void BM_FindChar(benchmark::State& state) {
+  std::string text = Haystack(state.range(0), false);
+  text.back() = '#';
+  View haystack(text.data(), text.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(haystack.find('#'));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_FindChar, absl::string_view)->Apply(SizeArgs);
+BENCHMARK_TEMPLATE(BM_FindChar, std::string_view)->Apply(SizeArgs);
+
+void BM_FindCharMemchr(benchmark::State& state) {
+  std::string text = Haystack(state.range(0), false);
+  text.back() = '#';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(memchr(text.data(), '#', text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindCharMemchr)->Apply(SizeArgs);
+
+// A set of delimiters of which only the last byte is one.
+constexpr char kDelimiters[] = " \t\n,;:|#";
+
+template <typename View>
+void BM_FindFirstOf(benchmark::State& state) {
+  std::string text = Haystack(state.range(0), false);
+  text.back() = '#';
+  View haystack(text.data(), text.size());
+  View set(kDelimiters, sizeof(kDelimiters) - 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(haystack.find_first_of(set));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_FindFirstOf, absl::string_view)->Apply(SizeArgs);
+BENCHMARK_TEMPLATE(BM_FindFirstOf, std::string_view)->Apply(SizeArgs);
+
+void BM_FindFirstOfStrpbrk(benchmark::State& state) {
+  std::string text = Haystack(state.range(0), false);
+  text.back() = '#';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(strpbrk(text.c_str(), kDelimiters));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindFirstOfStrpbrk)->Apply(SizeArgs);
+
+void BM_FindFirstOfStrcspn(benchmark::State& state) {
+  std::string text = Haystack(state.range(0), false);
+  text.back() = '#';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(strcspn(text.c_str(), kDelimiters));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindFirstOfStrcspn)->Apply(SizeArgs);
+
+// Two texts which differ in their last byte only.
+template <typename View>
+void BM_Compare(benchmark::State& state) {
+  const std::string& a = Haystack(state.range(0), false);
+  std::string b = a;
+  b.back() = '#';
+  View x(a.data(), a.size());
+  View y(b.data(), b.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x.compare(y));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Compare, absl::string_view)->Apply(SizeArgs);
+BENCHMARK_TEMPLATE(BM_Compare, std::string_view)->Apply(SizeArgs);
+BENCHMARK_TEMPLATE(BM_Compare, std::string)->Apply(SizeArgs);
+
+void BM_CompareMemcmp(benchmark::State& state) {
+  const std::string& a = Haystack(state.range(0), false);
+  std::string b = a;
+  b.back() = '#';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(memcmp(a.data(), b.data(), a.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CompareMemcmp)->Apply(SizeArgs);
+
+}  // namespace
+}  // namespace absl
+
+int main(int argc, char** argv) {
+  // Later flags win, so an explicit --benchmark_format overrides JSON.
+  static char json[] = "--benchmark_format=json";
+  std::vector<char*> args(argv, argv + argc);
+  args.insert(args.begin() + 1, json);
+  int count = static_cast<int>(args.size());
+  benchmark::Initialize(&count, args.data());
+  if (benchmark::ReportUnrecognizedArguments(count, args.data())) { return 1; }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -674,4 +674,19 @@ TEST(StringViewTest, Output) {
   EXPECT_EQ("   abc", ss.str());
 }
 
+TEST(StringViewTest, Constexpr) {
+  constexpr string_view s("hello world");
+  static_assert(s.size() == 11, "");
+  static_assert(s[4] == 'o' && s.front() == 'h' && s.back() == 'd', "");
+  static_assert(s.substr(6) == "world", "");
+  static_assert(s.compare("hello") > 0 && s < "help", "");
+  static_assert(s.starts_with("hello") && s.ends_with('d'), "");
+  static_assert(s.find('o') == 4 && s.find('o', 5) == 7, "");
+  static_assert(s.find('z') == string_view::npos, "");
+  static_assert(string_view().find('a') == string_view::npos, "");
+  constexpr string_view null_view(nullptr);
+  static_assert(null_view.empty(), "");
+  EXPECT_EQ(11, s.size());
+}
+
 }  // namespace absl
@@ -0,0 +1,137 @@
+#include "absl/utf8.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+
+namespace absl {
+
+using search_internal::SearchIsa;
+
+class Utf8ValidatorTest : public testing::TestWithParam<SearchIsa> {
+ protected:
+  void SetUp() override {
+    validator_ = utf8_internal::GetUtf8Validator(GetParam());
+    if (validator_ == nullptr) { GTEST_SKIP() << "Unsupported by the CPU"; }
+  }
+  bool Valid(const string& s) const { return validator_(s.data(), s.size()); }
+  utf8_internal::Validator validator_ = nullptr;
+};
+
+TEST_P(Utf8ValidatorTest, Valid) {
+  const string texts[] = {
+      "", "a", "plain ascii", "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80",
+      "\xed\x9f\xbf", "\xee\x80\x80", "\xef\xbf\xbf", "\xf0\x90\x80\x80",
+      "\xf4\x8f\xbf\xbf", "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"};
+  for (const auto& text : texts) {
+    EXPECT_TRUE(Valid(text)) << text;
+    // At every offset across the block boundaries.
+    for (size_t pad = 1; pad < 70; ++pad) {
+      EXPECT_TRUE(Valid(string(pad, 'x') + text)) << pad;
+      EXPECT_TRUE(Valid(text + string(pad, 'x'))) << pad;
+    }
+  }
+}
+
+TEST_P(Utf8ValidatorTest, Invalid) {
+  const string texts[] = {
+      "\x80", "\xbf", "\xc0\x80", "\xc1\xbf", "\xc2", "\xc2\x41",
+      "\xe0\x80\x80", "\xe0\x9f\xbf", "\xed\xa0\x80", "\xed\xbf\xbf",
+      "\xe1\x80", "\xf0\x80\x80\x80", "\xf0\x8f\xbf\xbf", "\xf4\x90\x80\x80",
+      "\xf5\x80\x80\x80", "\xff", "\xf0\x90\x80", "\xc2\x80\x80"};
+  for (const auto& text : texts) {
+    EXPECT_FALSE(Valid(text));
+    for (size_t pad = 1; pad < 70; ++pad) {
+      EXPECT_FALSE(Valid(string(pad, 'x') + text)) << pad;
+      EXPECT_FALSE(Valid(text + string(pad, 'x'))) << pad;
+    }
+  }
+}
+
+TEST_P(Utf8ValidatorTest, MatchesScalar) {
+  auto scalar = utf8_internal::GetUtf8Validator(SearchIsa::kScalar);
+  std::mt19937 rng(17);
+  const string pieces[] = {"a", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80",
+                           "\x80", "\xe0", "\xf4", "\xed"};
+  for (size_t n = 0; n < 200; n += 1 + n / 8) {
+    for (int round = 0; round < 50; ++round) {
+      string s;
+      while (s.size() < n) { s += pieces[rng() % 4]; }
+      // Mostly valid texts with a corruption or two.
+      if (rng() % 2 && !s.empty()) {
+        s[rng() % s.size()] = static_cast<char>(rng());
+      }
+      if (rng() % 4 == 0) { s += pieces[4 + rng() % 4]; }
+      EXPECT_EQ(scalar(s.data(), s.size()), Valid(s)) << n;
+    }
+  }
+}
+
+// There is no AVX-512 kernel; AVX2 runs at memory bandwidth already.
+INSTANTIATE_TEST_SUITE_P(
+    Isa, Utf8ValidatorTest,
+    testing::Values(SearchIsa::kScalar, SearchIsa::kSsse3, SearchIsa::kAvx2));
+
+TEST(Utf8Test, IsValidUtf8) {
+  EXPECT_TRUE(IsValidUtf8(""));
+  EXPECT_TRUE(IsValidUtf8("na\xc3\xafve"));
+  EXPECT_FALSE(IsValidUtf8("na\xc3ve"));
+}
+
+TEST(Utf8Test, Length) {
+  EXPECT_EQ(0u, Utf8Length(""));
+  EXPECT_EQ(5u, Utf8Length("na\xc3\xafve"));
+  EXPECT_EQ(17u, Utf8Length("\xe2\x82\xac\xf0\x9f\x98\x80 and more text!"));
+}
+
+TEST(Utf8Test, Decode) {
+  char32_t c;
+  EXPECT_EQ(1u, DecodeUtf8("A", &c));
+  EXPECT_EQ(U'A', c);
+  EXPECT_EQ(2u, DecodeUtf8("\xc3\xa9", &c));
+  EXPECT_EQ(U'\u00e9', c);
+  EXPECT_EQ(3u, DecodeUtf8("\xe2\x82\xac", &c));
+  EXPECT_EQ(U'\u20ac', c);
+  EXPECT_EQ(4u, DecodeUtf8("\xf0\x9f\x98\x80", &c));
+  EXPECT_EQ(U'\U0001f600', c);
+  EXPECT_EQ(1u, DecodeUtf8("\xe2\x82", &c));
+  EXPECT_EQ(kUnicodeReplacement, c);
+}
+
+TEST(Utf8Test, AppendRoundTrip) {
+  const char32_t code_points[] = {0, 0x7f, 0x80, 0x7ff, 0x800, 0xd7ff,
+                                  0xe000, 0xffff, 0x10000, 0x10ffff};
+  for (char32_t c : code_points) {
+    string s;
+    AppendUtf8(c, &s);
+    EXPECT_TRUE(IsValidUtf8(s));
+    char32_t decoded;
+    EXPECT_EQ(s.size(), DecodeUtf8(s, &decoded));
+    EXPECT_EQ(c, decoded);
+  }
+  string s;
+  AppendUtf8(0xd800, &s);
+  AppendUtf8(0x110000, &s);
+  EXPECT_EQ("\xef\xbf\xbd\xef\xbf\xbd", s);
+}
+
+TEST(Utf8Test, CodePoints) {
+  std::vector<char32_t> out;
+  for (char32_t c : Utf8CodePoints("a\xc3\xa9\xff\xe2\x82\xac")) {
+    out.push_back(c);
+  }
+  EXPECT_EQ((std::vector<char32_t>{U'a', U'\u00e9', kUnicodeReplacement,
+                                   U'\u20ac'}),
+            out);
+  Utf8CodePoints empty("");
+  EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(Utf8Test, ToValidUtf8) {
+  EXPECT_EQ("abc", ToValidUtf8("abc"));
+  EXPECT_EQ("a\xef\xbf\xbd" "b", ToValidUtf8("a\xc3" "b"));
+  EXPECT_EQ("\xef\xbf\xbd\xef\xbf\xbd\xe2\x82\xac",
+            ToValidUtf8("\xed\xa0\xe2\x82\xac"));
+}
+
+}  // namespace absl
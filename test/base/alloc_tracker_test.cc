@@ -0,0 +1,142 @@
+#include "base/alloc_tracker.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+
+// Built twice: as alloc_tracker_test in the default build, and as
+// alloc_tracking_test with XENIA_ALLOC_TRACKING.
+namespace base {
+
+// The pointers go through here, so that no new and delete pair is elided.
+static void* volatile sink;
+
+template <typename T>
+static T* Keep(T* p) {
+  sink = p;
+  return p;
+}
+
+#ifdef XENIA_ALLOC_TRACKING
+
+static AllocStats StatsOf(const char* tag) {
+  for (const auto& stats : GetAllocStats()) {
+    if (strcmp(stats.tag, tag) == 0) { return stats; }
+  }
+  return AllocStats{tag, 0, 0, 0, 0};
+}
+
+TEST(AllocTrackerTest, NestedScopes) {
+  char* outer;
+  char* inner;
+  char* after;
+  {
+    ALLOC_SCOPE("test_outer");
+    outer = Keep(new char[100]);
+    {
+      ALLOC_SCOPE("test_inner");
+      inner = Keep(new char[1000]);
+    }
+    after = Keep(new char[10]);
+  }
+  AllocStats stats = StatsOf("test_outer");
+  EXPECT_EQ(2u, stats.allocs);
+  EXPECT_EQ(110u, stats.bytes_allocated);
+  EXPECT_EQ(0u, stats.frees);
+  stats = StatsOf("test_inner");
+  EXPECT_EQ(1u, stats.allocs);
+  EXPECT_EQ(1000u, stats.bytes_allocated);
+
+  // Frees are charged to the tag of the allocation, whatever the scope.
+  {
+    ALLOC_SCOPE("test_inner");
+    delete[] outer;
+  }
+  delete[] after;
+  delete[] inner;
+  stats = StatsOf("test_outer");
+  EXPECT_EQ(2u, stats.frees);
+  EXPECT_EQ(110u, stats.bytes_freed);
+  stats = StatsOf("test_inner");
+  EXPECT_EQ(1u, stats.frees);
+  EXPECT_EQ(1000u, stats.bytes_freed);
+}
+
+TEST(AllocTrackerTest, SharedTagsAndThreads) {
+  // Scopes of the same tag share its counters, across call sites and
+  // threads.
+  int* mine;
+  {
+    ALLOC_SCOPE("test_shared");
+    mine = Keep(new int(1));
+  }
+  int* theirs = nullptr;
+  std::thread thread([&theirs] {
+    ALLOC_SCOPE("test_shared");
+    theirs = Keep(new int(2));
+  });
+  thread.join();
+  AllocStats stats = StatsOf("test_shared");
+  EXPECT_EQ(2u, stats.allocs);
+  EXPECT_EQ(2 * sizeof(int), stats.bytes_allocated);
+  delete theirs;
+  delete mine;
+  stats = StatsOf("test_shared");
+  EXPECT_EQ(2u, stats.frees);
+  EXPECT_EQ(stats.bytes_allocated, stats.bytes_freed);
+}
+
+TEST(AllocTrackerTest, OverAligned) {
+  struct alignas(256) Wide { char c[300]; };
+  Wide* wide;
+  {
+    ALLOC_SCOPE("test_aligned");
+    wide = Keep(new Wide);
+  }
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(wide) % 256);
+  AllocStats stats = StatsOf("test_aligned");
+  EXPECT_EQ(1u, stats.allocs);
+  EXPECT_EQ(sizeof(Wide), stats.bytes_allocated);
+  delete wide;
+  EXPECT_EQ(sizeof(Wide), StatsOf("test_aligned").bytes_freed);
+}
+
+TEST(AllocTrackerTest, RegisterAllocTag) {
+  const int id = RegisterAllocTag("test_register");
+  EXPECT_GT(id, 0);
+  EXPECT_EQ(id, RegisterAllocTag("test_register"));
+  EXPECT_NE(id, RegisterAllocTag("test_register_other"));
+  // Tags with no allocations are left out of the stats.
+  EXPECT_EQ(0u, StatsOf("test_register").allocs);
+}
+
+#else  // XENIA_ALLOC_TRACKING
+
+// The scope is an empty constant, with nothing to run at either end.
+constexpr int ScopedConstant() {
+  ALLOC_SCOPE("test_constexpr");
+  return 1;
+}
+static_assert(ScopedConstant() == 1, "ALLOC_SCOPE is not compiled away");
+static_assert(std::is_empty<NoAllocScope>::value &&
+                  std::is_trivially_destructible<NoAllocScope>::value,
+              "NoAllocScope is not empty");
+
+TEST(AllocTrackerTest, NothingTracked) {
+  {
+    ALLOC_SCOPE("test_untracked");
+    delete Keep(new int(1));
+  }
+  EXPECT_TRUE(GetAllocStats().empty());
+  // Does not log or fail.
+  SetAllocStatsInterval(1);
+  MaybeLogAllocStats();
+  MaybeLogAllocStats();
+  SetAllocStatsInterval(0);
+}
+
+#endif  // XENIA_ALLOC_TRACKING
+
+}  // namespace base
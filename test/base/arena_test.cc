@@ -0,0 +1,185 @@
+#include "base/arena.h"
+#include "gtest/gtest.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace base {
+
+static bool IsAligned(const void* p, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+TEST(ArenaTest, Alignment) {
+  Arena arena;
+  for (size_t alignment : {1, 2, 4, 8, 16, 64, 256, 4096}) {
+    // An odd size first, so that the next one needs padding.
+    arena.Allocate(3, 1);
+    void* p = arena.Allocate(10, alignment);
+    EXPECT_TRUE(IsAligned(p, alignment)) << alignment;
+  }
+  EXPECT_TRUE(IsAligned(arena.New<double>(1.5), alignof(double)));
+  EXPECT_TRUE(IsAligned(arena.Allocate(1), alignof(std::max_align_t)));
+  struct alignas(128) Wide { char c[3]; };
+  EXPECT_TRUE(IsAligned(arena.NewArray<Wide>(3), 128));
+}
+
+TEST(ArenaTest, ObjectsAndStrings) {
+  Arena arena;
+  int* ints = arena.NewArray<int>(100);
+  for (int i = 0; i < 100; ++i) { ints[i] = i; }
+  auto* pair = arena.New<std::pair<int, double>>(7, 2.5);
+  EXPECT_EQ(7, pair->first);
+  EXPECT_EQ(2.5, pair->second);
+  absl::string_view s = arena.CopyString("hello");
+  EXPECT_EQ("hello", s);
+  EXPECT_EQ('\0', s.data()[s.size()]);
+  EXPECT_EQ("", arena.CopyString(""));
+  for (int i = 0; i < 100; ++i) { EXPECT_EQ(i, ints[i]); }
+}
+
+TEST(ArenaTest, ChunkRollover) {
+  Arena::Options options;
+  options.chunk_size = 1024;
+  Arena arena(options);
+  EXPECT_EQ(0u, arena.stats().chunks);
+  std::vector<char*> blocks;
+  for (int i = 0; i < 100; ++i) {
+    auto* p = static_cast<char*>(arena.Allocate(100, 1));
+    memset(p, i, 100);
+    blocks.push_back(p);
+  }
+  // 10 blocks of 100 fit in a chunk of 1024.
+  EXPECT_EQ(10u, arena.stats().chunks);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(static_cast<char>(i), blocks[i][99]) << i;
+  }
+}
+
+TEST(ArenaTest, OversizedAllocations) {
+  Arena::Options options;
+  options.chunk_size = 1024;
+  Arena arena(options);
+  arena.Allocate(10, 1);
+  auto* big = static_cast<char*>(arena.Allocate(100000, 64));
+  EXPECT_TRUE(IsAligned(big, 64));
+  memset(big, 1, 100000);
+  ArenaStats stats = arena.stats();
+  EXPECT_EQ(2u, stats.chunks);
+  EXPECT_GE(stats.bytes_reserved, 1024u + 100000u);
+  // The rest of the first chunk is given up.
+  EXPECT_GE(stats.bytes_wasted, 1024u - 10u);
+}
+
+TEST(ArenaTest, RewindAndReset) {
+  Arena::Options options;
+  options.chunk_size = 1024;
+  Arena arena(options);
+  arena.Allocate(100, 1);
+  const Arena::Mark mark = arena.GetMark();
+  const ArenaStats before = arena.stats();
+  void* next = arena.Allocate(10, 1);
+  for (int i = 0; i < 50; ++i) { arena.Allocate(100, 1); }
+  const size_t chunks = arena.stats().chunks;
+  EXPECT_GT(chunks, 1u);
+
+  arena.Rewind(mark);
+  EXPECT_EQ(before.bytes_used, arena.stats().bytes_used);
+  EXPECT_EQ(before.bytes_wasted, arena.stats().bytes_wasted);
+  // The same memory comes back, and the chunks are kept for reuse.
+  EXPECT_EQ(next, arena.Allocate(10, 1));
+  for (int i = 0; i < 50; ++i) { arena.Allocate(100, 1); }
+  EXPECT_EQ(chunks, arena.stats().chunks);
+
+  arena.Reset();
+  EXPECT_EQ(0u, arena.stats().bytes_used);
+  EXPECT_EQ(0u, arena.stats().bytes_wasted);
+  void* first = arena.Allocate(1, 1);
+  arena.Reset();
+  EXPECT_EQ(first, arena.Allocate(1, 1));
+  EXPECT_EQ(chunks, arena.stats().chunks);
+}
+
+TEST(ArenaTest, Stats) {
+  Arena::Options options;
+  options.chunk_size = 1000;
+  Arena arena(options);
+  arena.Allocate(1, 1);
+  arena.Allocate(8, 8);
+  ArenaStats stats = arena.stats();
+  EXPECT_EQ(1u, stats.chunks);
+  EXPECT_EQ(1000u, stats.bytes_reserved);
+  EXPECT_EQ(9u, stats.bytes_used);
+  // The new[] chunk is aligned for anything, so 7 bytes pad the second.
+  EXPECT_EQ(7u, stats.bytes_wasted);
+  arena.Allocate(990, 1);
+  stats = arena.stats();
+  EXPECT_EQ(2u, stats.chunks);
+  EXPECT_EQ(999u, stats.bytes_used);
+  EXPECT_EQ(7u + 1000u - 16u, stats.bytes_wasted);
+}
+
+TEST(ArenaTest, Allocator) {
+  Arena arena;
+  std::vector<int, ArenaAllocator<int>> v(&arena);
+  for (int i = 0; i < 10000; ++i) { v.push_back(i); }
+  for (int i = 0; i < 10000; ++i) { ASSERT_EQ(i, v[i]); }
+  EXPECT_GE(arena.stats().bytes_used, 10000 * sizeof(int));
+  std::vector<int, ArenaAllocator<int>> copy(v, ArenaAllocator<int>(&arena));
+  EXPECT_EQ(v, copy);
+  ArenaAllocator<double> other(v.get_allocator());
+  EXPECT_EQ(&arena, other.arena());
+  EXPECT_TRUE(other == v.get_allocator());
+  Arena second;
+  EXPECT_TRUE(ArenaAllocator<int>(&second) != v.get_allocator());
+}
+
+TEST(ArenaTest, HugePages) {
+  Arena::Options options;
+  options.huge_pages = true;
+  options.chunk_size = 1 << 20;
+  Arena arena(options);
+  auto* p = static_cast<char*>(arena.Allocate(1 << 19));
+  memset(p, 1, 1 << 19);
+  // Huge page chunks are 2MB and aligned to it; without them, the chunk is
+  // as asked.
+  const uint64_t reserved = arena.stats().bytes_reserved;
+  if (reserved == (2u << 20)) {
+    EXPECT_TRUE(IsAligned(p, 2 << 20));
+  } else {
+    EXPECT_EQ(1u << 20, reserved);
+  }
+}
+
+// Allocates from an arena of huge pages with the address space limited so
+// that there is room for a chunk of 1MB, but not for the 4MB mapping which
+// aligns huge pages, and exits with 0 if that worked.
+static void AllocateWithoutRoomToMap() {
+  long pages = 0;
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm == nullptr || fscanf(statm, "%ld", &pages) != 1) { _exit(2); }
+  fclose(statm);
+  const rlim_t limit = pages * sysconf(_SC_PAGESIZE) + (3 << 20);
+  const rlimit rl = {limit, limit};
+  if (setrlimit(RLIMIT_AS, &rl) != 0) { _exit(3); }
+  Arena::Options options;
+  options.huge_pages = true;
+  options.chunk_size = 1 << 20;
+  Arena arena(options);
+  memset(arena.Allocate(1000), 1, 1000);
+  // Reserved huge pages may still be there to take.
+  const uint64_t reserved = arena.stats().bytes_reserved;
+  _exit(reserved == (1u << 20) || reserved == (2u << 20) ? 0 : 4);
+}
+
+// Where no memory can be mapped for huge pages, the chunks come from new.
+TEST(ArenaTest, HugePagesFallback) {
+  EXPECT_EXIT(AllocateWithoutRoomToMap(), testing::ExitedWithCode(0), "");
+}
+
+}  // namespace base
@@ -0,0 +1,175 @@
+#include "base/command_line_flags.h"
+#include "base/logging.h"
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+
+
+namespace base {
+
+// An argv of copies of args, with the nullptr after the last.
+class Argv {
+ public:
+  explicit Argv(std::vector<string> args) : args_(std::move(args)) {
+    for (auto& arg : args_) { pointers_.push_back(&arg[0]); }
+    pointers_.push_back(nullptr);
+    argc_ = static_cast<int>(args_.size());
+    argv_ = pointers_.data();
+  }
+  int* argc() { return &argc_; }
+  char*** argv() { return &argv_; }
+  std::vector<string> args() const {
+    return std::vector<string>(argv_, argv_ + argc_);
+  }
+  bool terminated() const { return argv_[argc_] == nullptr; }
+
+ private:
+  std::vector<string> args_;
+  std::vector<char*> pointers_;
+  int argc_;
+  char** argv_;
+};
+
+class CommandLineFlagsTest : public testing::Test {
+ protected:
+  CommandLineFlagsTest() {
+    flags_.AddBool("verbose", &verbose_);
+    flags_.AddInt("level", &level_);
+    flags_.AddString("name", &name_);
+  }
+
+  CommandLineFlags flags_;
+  bool verbose_ = false;
+  int level_ = 0;
+  string name_;
+};
+
+TEST_F(CommandLineFlagsTest, Forms) {
+  Argv argv({"app", "--level=3", "--name", "x", "--verbose"});
+  EXPECT_TRUE(flags_.Parse(argv.argc(), argv.argv(), false));
+  EXPECT_EQ(3, level_);
+  EXPECT_EQ("x", name_);
+  EXPECT_TRUE(verbose_);
+  EXPECT_TRUE(flags_.errors().empty());
+
+  Argv more({"app", "-level", "-4", "--noverbose", "-name=y=z"});
+  EXPECT_TRUE(flags_.Parse(more.argc(), more.argv(), false));
+  EXPECT_EQ(-4, level_);
+  EXPECT_FALSE(verbose_);
+  EXPECT_EQ("y=z", name_);
+
+  Argv bools({"app", "--verbose=yes"});
+  EXPECT_TRUE(flags_.Parse(bools.argc(), bools.argv(), false));
+  EXPECT_TRUE(verbose_);
+}
+
+TEST_F(CommandLineFlagsTest, RemoveFlags) {
+  Argv argv({"app", "a", "--level=3", "b", "--name", "x", "--unknown", "-",
+             "--", "--level=4", "c"});
+  EXPECT_TRUE(flags_.Parse(argv.argc(), argv.argv(), true));
+  EXPECT_EQ(3, level_);
+  EXPECT_EQ("x", name_);
+  EXPECT_EQ((std::vector<string>{"app", "a", "b", "--unknown", "-",
+                                 "--level=4", "c"}),
+            argv.args());
+  EXPECT_TRUE(argv.terminated());
+}
+
+TEST_F(CommandLineFlagsTest, KeepFlags) {
+  const std::vector<string> args = {"app", "a", "--level=3", "--", "b"};
+  Argv argv(args);
+  EXPECT_TRUE(flags_.Parse(argv.argc(), argv.argv(), false));
+  EXPECT_EQ(3, level_);
+  EXPECT_EQ(args, argv.args());
+}
+
+// Past "--", nothing is a flag.
+TEST_F(CommandLineFlagsTest, Terminator) {
+  Argv argv({"app", "--", "--level=3", "--verbose"});
+  EXPECT_TRUE(flags_.Parse(argv.argc(), argv.argv(), true));
+  EXPECT_EQ(0, level_);
+  EXPECT_FALSE(verbose_);
+  EXPECT_EQ((std::vector<string>{"app", "--level=3", "--verbose"}),
+            argv.args());
+}
+
+TEST_F(CommandLineFlagsTest, UnknownFlags) {
+  // Only booleans take the "no" prefix.
+  Argv argv({"app", "--other=1", "--nolevel", "--levels=2", "-x"});
+  EXPECT_TRUE(flags_.Parse(argv.argc(), argv.argv(), true));
+  EXPECT_EQ(0, level_);
+  EXPECT_EQ((std::vector<string>{"app", "--other=1", "--nolevel",
+                                 "--levels=2", "-x"}),
+            argv.args());
+}
+
+TEST_F(CommandLineFlagsTest, BadValues) {
+  level_ = 7;
+  Argv argv({"app", "--level=abc", "--verbose=maybe", "--name=ok",
+             "--level", "99999999999"});
+  EXPECT_FALSE(flags_.Parse(argv.argc(), argv.argv(), true));
+  EXPECT_EQ(7, level_);
+  EXPECT_FALSE(verbose_);
+  EXPECT_EQ("ok", name_);
+  ASSERT_EQ(3u, flags_.errors().size());
+  EXPECT_EQ("invalid value \"abc\" of flag level", flags_.errors()[0]);
+  EXPECT_EQ("invalid value \"maybe\" of flag verbose", flags_.errors()[1]);
+  EXPECT_EQ("invalid value \"99999999999\" of flag level",
+            flags_.errors()[2]);
+  // The flags are removed all the same.
+  EXPECT_EQ(std::vector<string>{"app"}, argv.args());
+
+  // The errors are those of the last parse.
+  Argv good({"app"});
+  EXPECT_TRUE(flags_.Parse(good.argc(), good.argv(), true));
+  EXPECT_TRUE(flags_.errors().empty());
+}
+
+TEST_F(CommandLineFlagsTest, MissingValue) {
+  Argv argv({"app", "--verbose", "--name"});
+  EXPECT_FALSE(flags_.Parse(argv.argc(), argv.argv(), true));
+  EXPECT_TRUE(verbose_);
+  EXPECT_EQ("", name_);
+  EXPECT_EQ(std::vector<string>{"missing value of flag name"},
+            flags_.errors());
+}
+
+TEST_F(CommandLineFlagsTest, Environment) {
+  setenv("XENIA_NAME", "from env", 1);
+  setenv("XENIA_LEVEL", "5", 1);
+  setenv("XENIA_VERBOSE", "true", 1);
+  Argv argv({"app", "--level=6"});
+  EXPECT_TRUE(flags_.Parse(argv.argc(), argv.argv(), true));
+  EXPECT_EQ("from env", name_);
+  EXPECT_TRUE(verbose_);
+  // The command line takes precedence.
+  EXPECT_EQ(6, level_);
+
+  setenv("XENIA_LEVEL", "five", 1);
+  Argv bad({"app"});
+  EXPECT_FALSE(flags_.Parse(bad.argc(), bad.argv(), true));
+  EXPECT_EQ(std::vector<string>{"invalid value \"five\" of flag level"},
+            flags_.errors());
+  unsetenv("XENIA_NAME");
+  unsetenv("XENIA_LEVEL");
+  unsetenv("XENIA_VERBOSE");
+}
+
+TEST(RegisterVLogModulesTest, MalformedItems) {
+  logging::ScopedLog log;
+  logging::RegisterVLogModules(
+      "bad,=3,command_line_flags_test.cc=abc,,other.cc=2,"
+      "command_line_flags_test.cc=2");
+  VLOG(2) << "at level 2";
+  VLOG(3) << "at level 3";
+  const string& text = log.log();
+  EXPECT_NE(string::npos, text.find("Invalid --vmodule item: bad\n"));
+  EXPECT_NE(string::npos, text.find("Invalid --vmodule item: =3\n"));
+  EXPECT_NE(string::npos,
+            text.find("Invalid --vmodule item: command_line_flags_test.cc"
+                      "=abc\n"));
+  EXPECT_NE(string::npos, text.find(" at level 2\n"));
+  EXPECT_EQ(string::npos, text.find(" at level 3\n"));
+}
+
+}  // namespace base
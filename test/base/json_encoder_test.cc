@@ -0,0 +1,69 @@
+#include "base/json_encoder.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+
+
+namespace base {
+
+template <typename T>
+static string Json(const T& value) {
+  string out;
+  AppendJsonValue(value, &out);
+  return out;
+}
+
+TEST(JsonEncoderTest, Strings) {
+  EXPECT_EQ("\"\"", Json(""));
+  EXPECT_EQ("\"plain text\"", Json("plain text"));
+  EXPECT_EQ("\"say \\\"hi\\\"\"", Json("say \"hi\""));
+  EXPECT_EQ("\"a\\\\b\"", Json("a\\b"));
+  EXPECT_EQ("\"\\b\\f\\n\\r\\t\"", Json("\b\f\n\r\t"));
+  EXPECT_EQ("\"\\u0000\\u0001\\u001f \"",
+            Json(absl::string_view("\0\x01\x1f ", 4)));
+  // Bytes past the first word, where the escapes are found a word at a time.
+  EXPECT_EQ("\"0123456789abcdef\\\"0123456789\\n\"",
+            Json("0123456789abcdef\"0123456789\n"));
+  // DEL and UTF-8 pass through.
+  EXPECT_EQ("\"\x7f\xc3\xa9\xe2\x82\xac\"", Json("\x7f\xc3\xa9\xe2\x82\xac"));
+}
+
+TEST(JsonEncoderTest, InvalidUtf8) {
+  // Each bad byte becomes U+FFFD, and the rest is escaped as usual.
+  EXPECT_EQ("\"a\xef\xbf\xbd\\\"\"", Json("a\xff\""));
+  EXPECT_EQ("\"\xef\xbf\xbd(\"", Json("\xc3("));
+  EXPECT_EQ("\"x\xef\xbf\xbd\xef\xbf\xbd\"", Json("x\xe2\x82"));
+}
+
+TEST(JsonEncoderTest, Numbers) {
+  EXPECT_EQ("0", Json(0));
+  EXPECT_EQ("-42", Json(-42));
+  EXPECT_EQ("-9223372036854775808",
+            Json(std::numeric_limits<int64_t>::min()));
+  EXPECT_EQ("18446744073709551615",
+            Json(std::numeric_limits<uint64_t>::max()));
+  EXPECT_EQ("7", Json(uint8_t{7}));
+  EXPECT_EQ("0.1", Json(0.1));
+  EXPECT_EQ("-2.5", Json(-2.5f));
+  EXPECT_EQ("1e+21", Json(1e21));
+  EXPECT_EQ("0.30000000000000004", Json(0.1 + 0.2));
+  EXPECT_EQ("null", Json(std::nan("")));
+  EXPECT_EQ("null", Json(std::numeric_limits<double>::infinity()));
+}
+
+TEST(JsonEncoderTest, Others) {
+  EXPECT_EQ("true", Json(true));
+  EXPECT_EQ("false", Json(false));
+  EXPECT_EQ("null", Json(nullptr));
+  EXPECT_EQ("null", Json(static_cast<const char*>(nullptr)));
+  EXPECT_EQ("\"s\"", Json(string("s")));
+  EXPECT_EQ("\"v\"", Json(absl::string_view("v")));
+  string out = "[";
+  AppendJsonValue(1, &out);
+  out += ",";
+  AppendJsonValue("x", &out);
+  EXPECT_EQ("[1,\"x\"", out);
+}
+
+}  // namespace base
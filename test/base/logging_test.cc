@@ -0,0 +1,231 @@
+#include "base/logging.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+
+namespace base {
+namespace logging {
+
+static size_t Lines(const string& log) {
+  return std::count(log.begin(), log.end(), '\n');
+}
+
+TEST(LoggingTest, ScopedLog) {
+  ScopedLog log;
+  LOG(INFO) << "hello " << 42;
+  EXPECT_NE(string::npos, log.log().find("logging_test.cc:"));
+  EXPECT_NE(string::npos, log.log().find(" hello 42\n"));
+}
+
+TEST(LoggingTest, WithFields) {
+  string text;
+  LOG(INFO).OutputToStringAndLog(&text).SetNoPrefix()
+      .With("int", -3).With("uint", 4u).With("bool", true)
+      .With("double", 0.5).With("string", "a \"b\"")
+      .With("view", absl::string_view("v")) << "fields";
+  EXPECT_EQ("fields {\"int\":-3,\"uint\":4,\"bool\":true,\"double\":0.5,"
+            "\"string\":\"a \\\"b\\\"\",\"view\":\"v\"}\n",
+            text);
+  // Fields alone make a message.
+  LOG(INFO).OutputToStringAndLog(&text).SetNoPrefix().With("k", 1);
+  EXPECT_EQ(" {\"k\":1}\n", text);
+}
+
+TEST(LoggingTest, TextAndJson) {
+  string text;
+  string json;
+  auto* device = new LogOutputStringDevice(&json);
+  device->SetFormat(JSON);
+  SetLogOutputDevice(device);
+  errno = ENOENT;
+  const int line = __LINE__ + 1;
+  PLOG(INFO).OutputToStringAndLog(&text).With("id", 7) << "open \"x\"";
+  const string location = "logging_test.cc:" + std::to_string(line);
+  EXPECT_EQ("I<Time> tid " + location +
+                " open \"x\": No such file or directory {\"id\":7}\n",
+            text);
+  EXPECT_EQ("{\"severity\":\"INFO\",\"tid\":\"tid\",\"file\":"
+            "\"logging_test.cc\",\"line\":" + std::to_string(line) +
+                ",\"msg\":\"open \\\"x\\\"\",\"errno\":" +
+                std::to_string(ENOENT) +
+                ",\"error\":\"No such file or directory\",\"id\":7}\n",
+            json);
+  SetLogOutputDevice(nullptr);
+}
+
+TEST(LoggingTest, CheckStrings) {
+  ScopedLog log;
+  const string upper = "Hello";
+  CHECK_STREQ("hello", "hello");
+  CHECK_STREQ(upper.c_str(), "Hello");
+  CHECK_STRNE("hello", upper.c_str());
+  CHECK_STRCASEEQ("hello", upper);
+  CHECK_STRCASEEQ(absl::string_view("MiXeD"), "mIxEd");
+  CHECK_STRCASENE("hello", "help");
+  CHECK_STRCASENE(upper, "Hello!");
+  EXPECT_EQ("", log.log());
+  EXPECT_DEATH(CHECK_STREQ("hello", upper.c_str()), "");
+  EXPECT_DEATH(CHECK_STRNE("a", "a"), "");
+  EXPECT_DEATH(CHECK_STRCASEEQ("hello", "help"), "");
+  EXPECT_DEATH(CHECK_STRCASENE("hello", upper), "");
+}
+
+// Logs at level from file, and returns whether it was logged.
+static bool VLogged(const char* file, int level) {
+  ScopedLog log;
+  LogMessage(file, 1, INFO).SetVerboseLevel(level) << "verbose";
+  return !log.log().empty();
+}
+
+// The modules cannot be unregistered, so the steps share one test, and
+// hold when it is repeated.
+TEST(LoggingTest, VLogModules) {
+  const char* file = __FILE__;
+  SetVLogLevel(1);
+  EXPECT_TRUE(VLogged("src/unmatched.cc", 1));
+  EXPECT_FALSE(VLogged("src/unmatched.cc", 2));
+
+  // Patterns match the base name. Of two, the first registered wins.
+  RegisterVLogModule(2, "logging_*");
+  RegisterVLogModule(4, "*_test.cc");
+  RegisterVLogModule(5, "other_*");
+  EXPECT_TRUE(VLogged(file, 2));
+  EXPECT_FALSE(VLogged(file, 3));
+  EXPECT_TRUE(VLogged("src/net_test.cc", 4));
+  EXPECT_FALSE(VLogged("src/net_test.cc", 5));
+  EXPECT_TRUE(VLogged("other_server.h", 5));
+
+  // An exact name goes before the patterns, even registered after them.
+  RegisterVLogModule(0, "exact_test.cc");
+  RegisterVLogModule(3, "logging_exact.cc");
+  EXPECT_FALSE(VLogged("src/exact_test.cc", 1));
+  EXPECT_TRUE(VLogged("logging_exact.cc", 3));
+  EXPECT_FALSE(VLogged("logging_exact.cc", 4));
+
+  // Other files keep the level of SetVLogLevel.
+  EXPECT_TRUE(VLogged("src/unmatched.cc", 1));
+  EXPECT_FALSE(VLogged("src/unmatched.cc", 2));
+  SetVLogLevel(2);
+  EXPECT_TRUE(VLogged("src/unmatched.cc", 2));
+  // VLOG uses the base name of __FILE__ as well.
+  ScopedLog log;
+  VLOG(2) << "at 2";
+  VLOG(3) << "at 3";
+  EXPECT_NE(string::npos, log.log().find(" at 2\n"));
+  EXPECT_EQ(string::npos, log.log().find(" at 3\n"));
+  SetVLogLevel(0);
+}
+
+// Each message goes to the sinks once for its severity and once for each
+// severity below it, so that a sink sees one copy per severity it accepts.
+TEST(LoggingTest, TeeFiltersFanOut) {
+  string all;
+  string warnings;
+  string errors;
+  auto* tee = new LogOutputTeeDevice();
+  tee->AddSink(new LogOutputStringDevice(&all), INFO);
+  tee->AddSink(new LogOutputStringDevice(&warnings), WARNING);
+  tee->AddSink(new LogOutputStringDevice(&errors), ERROR);
+  SetLogOutputDevice(tee);
+
+  LOG(ERROR) << "error";
+  ASSERT_TRUE(tee->Flush());
+  EXPECT_EQ(3u, Lines(all));
+  EXPECT_EQ(2u, Lines(warnings));
+  EXPECT_EQ(1u, Lines(errors));
+
+  LOG(WARNING) << "warning";
+  LOG(INFO) << "info";
+  ASSERT_TRUE(tee->Flush());
+  EXPECT_EQ(3u + 2u + 1u, Lines(all));
+  EXPECT_EQ(2u + 1u, Lines(warnings));
+  EXPECT_EQ(1u, Lines(errors));
+  EXPECT_EQ(string::npos, warnings.find(" info\n"));
+
+  // The same holds for messages which are not records.
+  tee->Send(INFO, "line\n");
+  ASSERT_TRUE(tee->Flush());
+  EXPECT_EQ(2u + 1u, Lines(warnings));
+  SetLogOutputDevice(nullptr);
+}
+
+// A device which counts what it gets, and which can be held up in Send
+// until it is opened.
+class GateDevice : public LogOutputDevice {
+ public:
+  struct State {
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool open = true;
+    int received = 0;
+  };
+
+  explicit GateDevice(State* state) : state_(state) { }
+  void Send(Severity, const string&) override {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    ++state_->received;
+    state_->changed.notify_all();
+    state_->changed.wait(lock, [this] { return state_->open; });
+  }
+  void Reset() override { }
+
+ private:
+  State* const state_;
+};
+
+static int Received(GateDevice::State* state) {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->received;
+}
+
+static void SetOpen(GateDevice::State* state, bool open) {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->open = open;
+  state->changed.notify_all();
+}
+
+// Waits until the device has got count messages, for at most a second.
+static bool AwaitReceived(GateDevice::State* state, int count) {
+  std::unique_lock<std::mutex> lock(state->mutex);
+  return state->changed.wait_for(lock, std::chrono::seconds(1), [&] {
+    return state->received >= count;
+  });
+}
+
+TEST(LoggingTest, TeeDropsWhenFull) {
+  GateDevice::State slow;
+  GateDevice::State fast;
+  SetOpen(&slow, false);
+  LogOutputTeeDevice tee;
+  const size_t slow_sink = tee.AddSink(new GateDevice(&slow), INFO, 2);
+  const size_t fast_sink = tee.AddSink(new GateDevice(&fast), INFO, 100);
+  // The slow sink's worker takes the first message and is stuck with it.
+  tee.Send(INFO, "first\n");
+  ASSERT_TRUE(AwaitReceived(&slow, 1));
+
+  // Its buffer takes two more, and the rest are dropped. Neither the
+  // caller nor the fast sink waits for it.
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 50; ++i) { tee.Send(INFO, "next\n"); }
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(500));
+  EXPECT_TRUE(AwaitReceived(&fast, 51));
+  EXPECT_EQ(1, Received(&slow));
+  EXPECT_EQ(48u, tee.dropped(slow_sink));
+  EXPECT_EQ(0u, tee.dropped(fast_sink));
+
+  SetOpen(&slow, true);
+  EXPECT_TRUE(tee.Flush());
+  EXPECT_EQ(3, Received(&slow));
+  EXPECT_EQ(51, Received(&fast));
+}
+
+}  // namespace logging
+}  // namespace base
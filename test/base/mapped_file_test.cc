@@ -0,0 +1,98 @@
+#include "base/mapped_file.h"
+#include "absl/string_dict.h"
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+
+
+namespace base {
+
+// Writes data to a new temporary file, and returns its path.
+static string WriteTempFile(absl::string_view data) {
+  string path = testing::TempDir() + "mapped_file_test.XXXXXX";
+  int fd = mkstemp(&path[0]);
+  EXPECT_GE(fd, 0);
+  EXPECT_EQ(static_cast<ssize_t>(data.size()),
+            write(fd, data.data(), data.size()));
+  close(fd);
+  return path;
+}
+
+TEST(MappedFileTest, Open) {
+  const string path = WriteTempFile("mapped bytes");
+  MappedFile file;
+  EXPECT_FALSE(file.is_open());
+  EXPECT_EQ("", file.data());
+  ASSERT_TRUE(file.Open(path)) << file.error();
+  EXPECT_TRUE(file.is_open());
+  EXPECT_EQ("mapped bytes", file.data());
+  EXPECT_EQ("", file.error());
+  file.Close();
+  EXPECT_FALSE(file.is_open());
+  EXPECT_EQ("", file.data());
+  unlink(path.c_str());
+}
+
+TEST(MappedFileTest, StringDict) {
+  absl::StringDictBuilder builder;
+  for (int i = 0; i < 1000; ++i) {
+    builder.Add("item." + std::to_string(i), "value " + std::to_string(i));
+  }
+  string bytes;
+  ASSERT_TRUE(builder.Build(&bytes));
+  const string path = WriteTempFile(bytes);
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path)) << file.error();
+  // The file stays mapped after it is gone.
+  unlink(path.c_str());
+  absl::StringDict dict;
+  ASSERT_TRUE(dict.Init(file.data()));
+  EXPECT_EQ(1000u, dict.size());
+  absl::string_view value;
+  ASSERT_TRUE(dict.Lookup("item.517", &value));
+  EXPECT_EQ("value 517", value);
+  EXPECT_FALSE(dict.Lookup("item.1000", &value));
+}
+
+TEST(MappedFileTest, EmptyFile) {
+  const string path = WriteTempFile("");
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path)) << file.error();
+  EXPECT_TRUE(file.is_open());
+  EXPECT_TRUE(file.data().empty());
+  unlink(path.c_str());
+}
+
+TEST(MappedFileTest, MissingFile) {
+  const string path = WriteTempFile("old");
+  unlink(path.c_str());
+  MappedFile file;
+  EXPECT_FALSE(file.Open(path));
+  EXPECT_FALSE(file.is_open());
+  EXPECT_EQ(0u, file.error().find("Cannot open " + path + ": "))
+      << file.error();
+}
+
+TEST(MappedFileTest, Move) {
+  const string path = WriteTempFile("moved");
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path)) << file.error();
+  const char* data = file.data().data();
+  MappedFile other(std::move(file));
+  EXPECT_FALSE(file.is_open());
+  EXPECT_TRUE(other.is_open());
+  EXPECT_EQ(data, other.data().data());
+  EXPECT_EQ("moved", other.data());
+
+  MappedFile third;
+  ASSERT_TRUE(third.Open(path)) << third.error();
+  third = std::move(other);
+  EXPECT_FALSE(other.is_open());
+  EXPECT_EQ(data, third.data().data());
+  EXPECT_EQ("moved", third.data());
+  unlink(path.c_str());
+}
+
+}  // namespace base
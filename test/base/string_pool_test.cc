@@ -0,0 +1,107 @@
+#include "base/string_pool.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+namespace base {
+
+static std::vector<string> Keys(int n) {
+  std::vector<string> keys;
+  for (int i = 0; i < n; ++i) { keys.push_back("key" + std::to_string(i)); }
+  return keys;
+}
+
+TEST(StringPoolTest, Intern) {
+  StringPool pool;
+  string a = "alpha";
+  absl::string_view first = pool.Intern(a);
+  EXPECT_EQ("alpha", first);
+  EXPECT_NE(a.data(), first.data());
+  EXPECT_EQ('\0', first.data()[first.size()]);
+  EXPECT_EQ(first.data(), pool.Intern(string("alpha")).data());
+  EXPECT_NE(first.data(), pool.Intern("alphabet").data());
+  EXPECT_EQ("", pool.Intern(""));
+  EXPECT_EQ(pool.Intern("").data(), pool.Intern(absl::string_view()).data());
+  EXPECT_EQ(3u, pool.size());
+  EXPECT_EQ(StringPool::Default(), StringPool::Default());
+}
+
+TEST(StringPoolTest, Ids) {
+  StringPool pool;
+  EXPECT_EQ(0u, pool.InternId("a"));
+  EXPECT_EQ(1u, pool.InternId("b"));
+  EXPECT_EQ(0u, pool.InternId("a"));
+  absl::string_view c = pool.Intern("c");
+  EXPECT_EQ(2u, pool.InternId("c"));
+  EXPECT_EQ(c.data(), pool.Lookup(2).data());
+  EXPECT_EQ("a", pool.Lookup(0));
+  EXPECT_EQ("b", pool.Lookup(1));
+}
+
+// Enough strings for the tables of each shard to double several times, and
+// for the ids to fill several segments.
+TEST(StringPoolTest, Growth) {
+  StringPool pool;
+  const std::vector<string> keys = Keys(100000);
+  std::vector<absl::string_view> views;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(i, pool.InternId(keys[i]));
+    views.push_back(pool.Intern(keys[i]));
+  }
+  EXPECT_EQ(keys.size(), pool.size());
+  // What was interned stays where it was as the tables grow.
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(views[i].data(), pool.Intern(keys[i]).data());
+    ASSERT_EQ(views[i].data(), pool.Lookup(i).data());
+    ASSERT_EQ(keys[i], pool.Lookup(i));
+  }
+}
+
+TEST(StringPoolTest, Threads) {
+  constexpr int kThreads = 8;
+  StringPool pool;
+  const std::vector<string> keys = Keys(20000);
+  std::vector<std::vector<absl::string_view>> views(kThreads);
+  std::vector<std::vector<uint32_t>> ids(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      // Each thread takes the keys in its own order, and looks up the ids
+      // it gets while the others are still adding.
+      std::vector<size_t> order(keys.size());
+      for (size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+      std::shuffle(order.begin(), order.end(), std::mt19937(t));
+      views[t].resize(keys.size());
+      ids[t].resize(keys.size());
+      for (size_t i : order) {
+        views[t][i] = pool.Intern(keys[i]);
+        ids[t][i] = pool.InternId(keys[i]);
+        if (pool.Lookup(ids[t][i]).data() != views[t][i].data()) {
+          ids[t][i] = UINT32_MAX;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+
+  ASSERT_EQ(keys.size(), pool.size());
+  std::vector<bool> seen(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(keys[i], views[0][i]);
+    const uint32_t id = ids[0][i];
+    ASSERT_LT(id, keys.size());
+    ASSERT_FALSE(seen[id]) << id;
+    seen[id] = true;
+    for (int t = 1; t < kThreads; ++t) {
+      ASSERT_EQ(views[0][i].data(), views[t][i].data());
+      ASSERT_EQ(id, ids[t][i]);
+    }
+    ASSERT_EQ(views[0][i].data(), pool.Lookup(id).data());
+  }
+}
+
+}  // namespace base